@@ -18,7 +18,7 @@ REM Create build directory
 if not exist build mkdir build
 
 REM Compile all source files directly
-g++ -std=c++17 ^
+g++ -std=c++20 ^
     -I"include" ^
     -I"C:/SFML/include" ^
     -I"C:/nlohmann-json/include" ^
@@ -29,6 +29,22 @@ g++ -std=c++17 ^
     src/StateStack.cpp ^
     src/core/RNG.cpp ^
     src/core/AudioManager.cpp ^
+    src/core/SoundBank.cpp ^
+    src/core/EventBus.cpp ^
+    src/core/Profiler.cpp ^
+    src/core/Autopilot.cpp ^
+    src/core/InputRecorder.cpp ^
+    src/core/JobSystem.cpp ^
+    src/core/RenderList.cpp ^
+    src/core/TaskScheduler.cpp ^
+    src/core/LinearArena.cpp ^
+    src/core/AllocationCounter.cpp ^
+    src/core/CombatEngine.cpp ^
+    src/core/CombatSolver.cpp ^
+    src/core/CombatSearch.cpp ^
+    src/core/TypeChart.cpp ^
+    src/core/CombatLog.cpp ^
+    src/core/StatusSet.cpp ^
     src/core/AssetManager.cpp ^
     src/core/SaveSystem.cpp ^
     src/states/State.cpp ^
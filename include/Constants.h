@@ -5,11 +5,21 @@ namespace Constants {
     constexpr int SCREEN_WIDTH = 1280;
     constexpr int SCREEN_HEIGHT = 720;
     constexpr int TARGET_FPS = 60;
+    constexpr float HEADLESS_STALL_SECONDS = 600.0f; // Abort a headless run after 10 simulated minutes without a turn
+    constexpr int REPLAY_CHECKPOINT_TICKS = 60;        // State hash written to input logs once per simulated second
+    constexpr int MAX_CATCHUP_STEPS = 5;               // Fixed steps per frame (at 1x) before the backlog is dropped
+    constexpr int UNFOCUSED_FPS = 15;                  // Frame cap while the window is in the background
+    constexpr int FRAME_ARENA_SIZE = 64 * 1024;        // Initial per-thread frame arena; regrows to the busiest frame
+
+    // Every text size the UI uses (30 is the sf::Text default); glyphs for these
+    // are rasterized up front when the simulation runs on its own thread
+    constexpr unsigned int UI_FONT_SIZES[] = { 12, 14, 16, 18, 24, 28, 30, 32, 36, 48, 72, 96 };
     
     // Map settings
     constexpr int MAP_WIDTH = 30;
     constexpr int MAP_HEIGHT = 30;
     constexpr int TILE_SIZE = 32;
+    constexpr int MAP_SCRATCH_ARENA_SIZE = 32 * 1024;  // Generation scratch: candidate lists and visited grids
     constexpr int START_X = 1;
     constexpr int START_Y = 1;
     constexpr int GOAL_X = 28;
@@ -45,6 +55,12 @@ namespace Constants {
     constexpr int BASE_BOSS_ATK = 25;
     constexpr int BASE_BOSS_DEF = 12;
     constexpr float BOSS_DAMAGE_REDUCTION = 0.9f; // Resolute passive
+
+    // Boss move search (CombatSearch). Bounded by nodes and depth only, never
+    // by time, so the boss picks the same move on any machine and in any build
+    constexpr int BOSS_SEARCH_NODES = 16000;
+    constexpr int BOSS_SEARCH_DEPTH = 16;
+    constexpr float BOSS_SEARCH_PLAYER_SKILL = 0.5f;  // How well the boss expects the player to play
     
     // Damage calculation
     constexpr float DAMAGE_VARIANCE_MIN = 0.9f;
@@ -55,11 +71,18 @@ namespace Constants {
     constexpr float TYPE_SUPER_EFFECTIVE = 1.5f;
     constexpr float TYPE_NOT_VERY_EFFECTIVE = 0.5f;
     constexpr float TYPE_NORMAL_EFFECTIVE = 1.0f;
+    constexpr float TYPE_NO_EFFECT = 0.0f;
 
     // Enhanced combat settings
     constexpr float MONSTER_DODGE_CHANCE = 0.3f;     // 30% chance for monsters to dodge
     constexpr int PIKACHU_ATTACK_SKILLS = 3;         // ThunderBolt, QuickAttack, IronTail
     constexpr int PIKACHU_DEFENSE_SKILLS = 3;        // Agility, DoubleTeam, Substitute
+
+    // Power Strike and Guard, as Skills::Table lists them and the enemy plays them
+    constexpr int POWER_STRIKE_MP_COST = 8;
+    constexpr float POWER_STRIKE_MULTIPLIER = 1.6f;
+    constexpr int GUARD_MP_COST = 6;
+    constexpr float GUARD_DAMAGE_TAKEN = 0.6f;       // Incoming damage scale while guarding
     
     // Progression
     constexpr int EVOLUTION_LEVEL = 5;
@@ -86,6 +109,8 @@ namespace Constants {
     
     // File paths
     const char* const SAVE_FILE_PATH = "save.json";
+    const char* const PROFILE_TRACE_PATH = "profile_trace.json";  // Open in chrome://tracing or Perfetto
+    const char* const COMBAT_EXPORT_PATH = "combat_log.bin";      // Battles appended when built with ENABLE_COMBAT_EXPORT
     const char* const FONT_PATH = "assets/fonts/arial.ttf";
 
     // Icon paths (PNG files in assets/icon/)
@@ -105,4 +130,9 @@ namespace Constants {
     const char* const SFX_COIN = "assets/audio/sfx_coin.ogg";
     const char* const SFX_DICE = "assets/audio/sfx_dice.ogg";
     const char* const SFX_HIT = "assets/audio/sfx_hit.ogg";
+
+    // Sound bank: every effect listed here is decoded at startup
+    const char* const SFX_MANIFEST[] = { SFX_COIN, SFX_DICE, SFX_HIT };
+    constexpr bool SFX_KEEP_COMPRESSED = false;      // Trade decode latency for memory
+    constexpr int SFX_DECODE_CACHE_SIZE = 2;         // Decoded effects kept when compressed
 }
@@ -1,25 +1,50 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include "StateStack.h"
 #include "core/AudioManager.h"
 #include "core/AssetManager.h"
 #include "core/RNG.h"
 #include "core/SaveSystem.h"
+#include "core/EventBus.h"
+#include "core/InputRecorder.h"
+#include "core/JobSystem.h"
+#include "core/RenderList.h"
+#include "core/TripleBuffer.h"
 #include "Constants.h"
 
+// Command-line run options
+struct GameOptions {
+    bool headless = false;             // --headless: no window, rendering or audio
+    std::size_t headlessTurns = 1000;  // --turns N: stop after N completed map turns
+    bool hasSeed = false;              // --seed S: fixed RNG seed
+    unsigned int seed = 0;
+    std::string recordFile;            // --record FILE: log input of a windowed session
+    std::string replayFile;            // --replay FILE: re-run a logged session at max speed
+    bool threaded = false;             // --threaded: simulation on its own thread, rendering from snapshots
+    float timeScale = 1.0f;            // --time-scale X: simulation speed of windowed runs (0 = unbounded)
+    bool idleWait = true;              // --no-idle: keep stepping and redrawing static screens
+};
+
 class Game {
 public:
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
     ~Game();
     
     void run();
+    int getExitCode() const { return m_exitCode; }
     
     // Getters for global systems
     AudioManager& getAudioManager() { return m_audioManager; }
     AssetManager& getAssetManager() { return m_assetManager; }
     RNG& getRNG() { return m_rng; }
     SaveSystem& getSaveSystem() { return m_saveSystem; }
+    JobSystem& getJobSystem() { return m_jobSystem; }
     sf::RenderWindow& getWindow() { return m_window; }
     
     // Game state management
@@ -32,20 +57,100 @@ private:
     void processInput();
     void update(sf::Time deltaTime);
     void render();
+    void runHeadless();
+    void runReplay();
+    void runThreaded();
+    void simulationLoop(std::atomic<bool>& running);
+    void dispatchEvent(const sf::Event& event);
+    void queueEvent(const sf::Event& event, sf::Time timestamp);
+    void deliverInput(sf::Time upTo);
+    bool isIdle() const;
+    void trackStateCpu(StateID state, double cpuSeconds, sf::Time wall);
+    void trackDisplayedInput(std::uint64_t dispatched);
+    void beginFrame();
+    void reportTelemetry() const;
+    static bool isLatencyProbe(const sf::Event& event);
     
     void registerStates();
     void updateStatistics(sf::Time deltaTime);
     
 private:
+    GameOptions m_options;
     sf::RenderWindow m_window;
-    StateStack m_stateStack;
     
     // Global systems
     AudioManager m_audioManager;
     AssetManager m_assetManager;
     RNG m_rng;
     SaveSystem m_saveSystem;
+    EventBus m_eventBus;
+    JobSystem m_jobSystem;      // Declared after the systems so in-flight jobs finish before they go away
+
+    // After everything states reach through their Context: states unsubscribe
+    // from the event bus as they are destroyed
+    StateStack m_stateStack;
+
+    // Deterministic input log; m_tick counts fixed updates since startup
+    InputRecorder m_recorder;
+    InputPlayer m_replay;
+    std::uint64_t m_tick;
+
+    // Input is sampled once per rendered frame and stamped on m_inputClock;
+    // each event then waits for the fixed step whose slot covers its stamp
+    struct TimedEvent {
+        sf::Event event;
+        sf::Time timestamp;
+    };
+    sf::Clock m_inputClock;
+    std::deque<TimedEvent> m_inputQueue;
+
+    // Input-to-display latency, measured on key and button presses
+    std::deque<sf::Time> m_inputInFlight;   // Poll times of presses not yet on screen
+    std::uint64_t m_inputDispatched;        // Presses handed to the states so far
+    std::uint64_t m_inputDisplayed;         // Presses whose tick has been presented
+    std::size_t m_latencySamples;
+    sf::Time m_latencyTotal;
+    sf::Time m_latencyMax;
+
+    // Simulation time discarded by the catch-up cap after hitches
+    sf::Time m_droppedTime;
+    std::size_t m_droppedFrames;
+
+    // How far the last rendered frame is past the last fixed step, in steps [0, 1)
+    float m_interpolationAlpha;
+
+    // Background windows are throttled to UNFOCUSED_FPS
+    bool m_hasFocus;
+
+    // Process CPU time against wall time, attributed to the top state of each frame
+    struct StateCpu {
+        double cpuSeconds = 0.0;
+        double wallSeconds = 0.0;
+    };
+    static constexpr std::size_t StateCount = static_cast<std::size_t>(StateID::Pause) + 1;
+    std::array<StateCpu, StateCount> m_stateCpu;
+    std::size_t m_idleWaits;
+
+    // Global-heap allocations per frame (per tick without a window), sampled
+    // in beginFrame() along with the frame arena reset
+    std::uint64_t m_allocationMark;     // Counter value when the current frame began, 0 before the first
+    std::uint64_t m_allocationFrames;
+    std::uint64_t m_allocationTotal;
+    std::uint64_t m_allocationMax;
+    std::uint64_t m_allocationLast;     // Most recent finished frame
     
+    // Threaded mode: the simulation thread records each tick's draw calls and
+    // the render thread replays the newest one
+    struct RenderSnapshot {
+        std::uint64_t tick = 0;
+        std::uint64_t inputDispatched = 0;
+        RenderList drawList;
+    };
+    TripleBuffer<RenderSnapshot> m_snapshots;
+    std::mutex m_inputMutex;
+    std::vector<sf::Event> m_pendingInput;  // Polled by the render thread, drained per tick
+    sf::Vector2u m_renderSize;              // Simulation thread's copy of the window size
+
     // Performance tracking
     sf::Time m_statisticsUpdateTime;
     std::size_t m_statisticsNumFrames;
@@ -53,6 +158,7 @@ private:
     
     // Game state
     bool m_isPaused;
+    int m_exitCode;
     
     static const sf::Time TimePerFrame;
 };
@@ -4,6 +4,7 @@
 #include <memory>
 #include <functional>
 #include <map>
+#include <set>
 #include "states/State.h"
 #include "Types.h"
 
@@ -20,9 +21,14 @@ public:
     
     template <typename T>
     void registerState(StateID stateID);
+
+    // Pooled states are built once and kept alive after being popped
+    template <typename T>
+    void registerPooledState(StateID stateID);
+    void prewarmState(StateID stateID);
     
     void update(sf::Time dt);
-    void draw();
+    void draw(RenderList& target);
     void handleEvent(const sf::Event& event);
     
     void pushState(StateID stateID);
@@ -30,10 +36,21 @@ public:
     void clearStates();
     
     bool isEmpty() const;
+
+    // True while the top state animates or a stack change is pending
+    bool isAnimating() const;
+    StateID getTopStateID() const;
+
+    // Combined hash of every active state, bottom to top
+    std::uint64_t stateHash() const;
+
+    // Time from the last push request until its first drawn frame
+    sf::Time getLastPushLatency() const { return m_lastPushLatency; }
     
 private:
     State::Ptr createState(StateID stateID);
     void applyPendingChanges();
+    void removeTopState();
     
 private:
     struct PendingChange {
@@ -42,11 +59,27 @@ private:
     };
     
 private:
-    std::vector<State::Ptr> m_stack;
+    struct ActiveState {
+        StateID stateID;
+        State::Ptr state;
+    };
+
+private:
+    std::vector<ActiveState> m_stack;
     std::vector<PendingChange> m_pendingList;
     
     State::Context m_context;
     std::map<StateID, std::function<State::Ptr()>> m_factories;
+
+    // Idle instances of pooled states, ready for the next push
+    std::map<StateID, State::Ptr> m_pool;
+    std::set<StateID> m_pooledIDs;
+
+    // Push-to-first-frame measurement
+    sf::Clock m_pushClock;
+    bool m_measuringPush;
+    bool m_pushWasWarm;
+    sf::Time m_lastPushLatency;
 };
 
 template <typename T>
@@ -55,3 +88,9 @@ void StateStack::registerState(StateID stateID) {
         return State::Ptr(new T(*this, m_context));
     };
 }
+
+template <typename T>
+void StateStack::registerPooledState(StateID stateID) {
+    registerState<T>(stateID);
+    m_pooledIDs.insert(stateID);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/System/Vector2.hpp>
+#include "core/TypeChart.h"
 #include <vector>
 #include <string>
 
@@ -39,11 +40,7 @@ enum class Direction {
     Right
 };
 
-enum class PokemonType {
-    Fire,
-    Water,
-    Grass
-};
+// PokemonType lives in core/TypeChart.h with its effectiveness matrix
 
 enum class CombatResult {
     None,
@@ -137,7 +134,7 @@ struct SkillData {
     bool hasSpecialEffect;
     
     SkillData() = default;
-    SkillData(SkillType t, int mp, int cd, float dmg = 0.0f, float heal = 0.0f, 
+    constexpr SkillData(SkillType t, int mp, int cd, float dmg = 0.0f, float heal = 0.0f, 
               bool off = true, bool def = false, bool special = false)
         : type(t), mpCost(mp), cooldown(cd), damageMultiplier(dmg), 
           healMultiplier(heal), isOffensive(off), isDefensive(def), hasSpecialEffect(special) {}
@@ -239,6 +236,21 @@ inline const char* pokemonTypeToString(PokemonType type) {
         case PokemonType::Fire: return "Fire";
         case PokemonType::Water: return "Water";
         case PokemonType::Grass: return "Grass";
+        case PokemonType::Normal: return "Normal";
+        case PokemonType::Electric: return "Electric";
+        case PokemonType::Ice: return "Ice";
+        case PokemonType::Fighting: return "Fighting";
+        case PokemonType::Poison: return "Poison";
+        case PokemonType::Ground: return "Ground";
+        case PokemonType::Flying: return "Flying";
+        case PokemonType::Psychic: return "Psychic";
+        case PokemonType::Bug: return "Bug";
+        case PokemonType::Rock: return "Rock";
+        case PokemonType::Ghost: return "Ghost";
+        case PokemonType::Dragon: return "Dragon";
+        case PokemonType::Dark: return "Dark";
+        case PokemonType::Steel: return "Steel";
+        case PokemonType::Fairy: return "Fairy";
     }
     return "Unknown";
 }
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+// Counts calls to the global operator new (replaced in AllocationCounter.cpp)
+// from every thread. The game loop samples it once per frame to show how many
+// heap allocations a frame costs.
+namespace AllocationCounter {
+    // Global allocations since startup
+    std::uint64_t count();
+}
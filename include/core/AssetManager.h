@@ -4,6 +4,8 @@
 #include <string>
 #include <memory>
 
+class JobSystem;
+
 class AssetManager {
 public:
     AssetManager();
@@ -17,8 +19,8 @@ public:
     const sf::Texture& getTexture(const std::string& filename);
     void loadTexture(const std::string& id, const std::string& filename);
 
-    // Game asset loading
-    void loadAll();
+    // Game asset loading; image decode is spread over the job system
+    void loadAll(JobSystem& jobs);
     void loadGameTexture(const std::string& key, const std::string& path);
     void loadTransparentTexture(const std::string& key, const std::string& path);
     void loadGameFont(const std::string& key, const std::string& path);
@@ -37,6 +39,10 @@ public:
     void placeBottomLeft(sf::Sprite& sprite, sf::Vector2f anchorBL) const;
     void placeTopRight(sf::Sprite& sprite, sf::Vector2f anchorTR) const;
 
+    // Rasterizes printable ASCII for every UI text size so later text layout
+    // only reads the glyph pages (needed once text is built off the render thread)
+    void prewarmGlyphs();
+
     // Default assets
     const sf::Font& getDefaultFont();
     sf::Texture& getDefaultTexture();
@@ -57,5 +63,6 @@ private:
     std::unique_ptr<sf::Texture> m_defaultTexture;
 
     void createDefaultAssets();
+    void uploadGameTexture(const std::string& key, const std::string& path, const sf::Image* image, bool transparent);
     sf::Texture& getPlaceholderTexture();
 };
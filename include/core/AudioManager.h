@@ -1,46 +1,123 @@
 #pragma once
 #include <SFML/Audio.hpp>
+#include "core/SoundBank.h"
+#include <array>
+#include <cstdint>
+#include <future>
 #include <map>
-#include <string>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 class AudioManager {
+public:
+    // Handle to a loaded sound effect (index into the sound bank)
+    using SoundHandle = SoundBank::Handle;
+    static constexpr SoundHandle InvalidSound = SoundBank::InvalidHandle;
+
+    // Number of preallocated voices shared by all sound effects
+    static constexpr std::size_t MaxVoices = 16;
+
+    // Higher priority sounds may steal voices from lower priority ones
+    enum class Priority {
+        Low,
+        Normal,
+        High
+    };
+
 public:
     AudioManager();
     ~AudioManager();
-    
-    // Music management
-    void playMusic(const std::string& filename, bool loop = true);
+
+    // Music management (tracks should be prefetched; playMusic never touches the disk)
+    void playMusic(const std::string& filename, bool loop = true, sf::Time fade = sf::seconds(1.0f));
+    void prefetchMusic(const std::string& filename);
     void stopMusic();
     void pauseMusic();
     void resumeMusic();
     void setMusicVolume(float volume);
-    
+
     // Sound effects
+    bool loadSoundBank(const std::vector<std::string>& manifest, JobSystem& jobs,
+                       SoundBank::Storage storage = SoundBank::Storage::Decoded);
+    void setSoundCacheCapacity(std::size_t capacity);
+    const SoundBank& getSoundBank() const { return m_soundBank; }
+    SoundHandle loadSound(const std::string& filename);
+    void playSound(SoundHandle handle, Priority priority = Priority::Normal);
     void playSound(const std::string& filename);
+    void stopAllSounds();
     void setSoundVolume(float volume);
-    
+
     // Global volume
     void setMasterVolume(float volume);
     float getMasterVolume() const;
-    
+
     // Mute functionality
     void setMuted(bool muted);
     bool isMuted() const;
-    
+
+    // Disabled audio never touches files or devices (headless runs)
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // Advances crossfades and starts tracks whose prefetch just finished
+    void update(sf::Time dt);
+
+    // False while update() still has work: a crossfade, a load or a queued track
+    bool isIdle() const;
+
 private:
-    void loadSound(const std::string& filename);
-    
+    using TrackData = std::shared_ptr<const std::vector<char>>;
+
+    // Two decks so the incoming track can fade in while the outgoing one fades out
+    struct MusicDeck {
+        TrackData data;         // Declared first so it outlives the stream music opens from it
+        sf::Music music;
+        std::string track;
+        float gain = 0.0f;
+    };
+
+    struct Voice {
+        sf::Sound sound;
+        Priority priority = Priority::Low;
+        std::uint64_t startedAt = 0;
+    };
+
+    Voice* acquireVoice(Priority priority);
+    bool isBufferPlaying(const sf::SoundBuffer& buffer) const;
+
+    void startTrack(const std::string& filename, TrackData data, bool loop, sf::Time fade);
+    void collectPrefetchedMusic();
+    void applyMusicVolume();
+
 private:
-    sf::Music m_music;
-    std::map<std::string, sf::SoundBuffer> m_soundBuffers;
-    std::vector<std::unique_ptr<sf::Sound>> m_sounds;
-    
+    std::array<MusicDeck, 2> m_decks;
+    std::size_t m_activeDeck;
+    bool m_fading;
+    sf::Time m_fadeElapsed;
+    sf::Time m_fadeDuration;
+
+    // Encoded tracks kept in memory; loads run on worker threads
+    std::map<std::string, TrackData> m_musicCache;
+    std::map<std::string, std::future<std::vector<char>>> m_musicLoads;
+    // Tracks that could not be read or opened; warned about once, never retried
+    std::set<std::string> m_failedTracks;
+
+    // Track requested before its prefetch finished
+    std::string m_queuedTrack;
+    bool m_queuedLoop;
+    sf::Time m_queuedFade;
+
+    SoundBank m_soundBank;
+
+    // Declared after the bank so voices are stopped before buffers are destroyed
+    std::array<Voice, MaxVoices> m_voices;
+    std::uint64_t m_playCounter;
+
     float m_masterVolume;
     float m_musicVolume;
     float m_soundVolume;
     bool m_muted;
-    
-    // Clean up finished sounds
-    void cleanupSounds();
+    bool m_enabled;
 };
@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/Window/Event.hpp>
+#include "core/EventBus.h"
+#include "core/RNG.h"
+#include "Types.h"
+
+// Plays the game without a player for headless runs: picks a synthetic key
+// press for whichever state is on top and counts progress from the event bus.
+class Autopilot {
+public:
+    struct Stats {
+        std::size_t turns = 0;
+        std::size_t combats = 0;
+        std::size_t victories = 0;
+        std::size_t defeats = 0;
+        std::size_t games = 0;
+    };
+
+public:
+    Autopilot(EventBus& events, unsigned int seed);
+    ~Autopilot();
+
+    Autopilot(const Autopilot&) = delete;
+    Autopilot& operator=(const Autopilot&) = delete;
+
+    // Returns false when the state needs no input this tick
+    bool nextEvent(StateID topState, sf::Event& event);
+
+    void onGameFinished() { ++m_stats.games; }
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    static sf::Event keyPress(sf::Keyboard::Key key);
+
+private:
+    EventBus& m_events;
+    RNG m_choices;      // Separate from the game RNG so choices do not shift game rolls
+    Stats m_stats;
+    int m_combatStep;
+    EventBus::SubscriptionID m_turnSub;
+    EventBus::SubscriptionID m_combatSub;
+};
@@ -0,0 +1,207 @@
+#pragma once
+#include "Constants.h"
+#include "core/StatusSet.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum class PikaAtkSkill {
+    Thunderbolt,
+    ElectroBall,
+    VoltTackle
+};
+
+enum class PikaDefSkill {
+    QuickGuard,
+    Agility,
+    Charge
+};
+
+// The combat rules with nothing else attached: no window, timers, audio or
+// log. A battle is a trivially copyable State advanced one player decision at
+// a time by step(action, rng); CombatState presents it and runs the timing
+// around it, simulations and search code drive it directly.
+//
+// step() is instantiated for RNG (the game) and FastRNG (tools); both roll
+// through rollRange(min, max) in the same order, so a seeded game session
+// replays exactly.
+class CombatEngine {
+public:
+    enum class Phase : std::uint8_t {
+        CoinChoice,     // Waiting for the player to call the coin
+        Action,         // Coin landed: Attack, or a skill if the call was right
+        Victory,
+        Defeat
+    };
+
+    enum class Action : std::uint8_t {
+        CallHead,       // Call the coin and flip it
+        CallTail,
+        Attack,         // Strike from the coin result screen
+        Skill1,         // Skills of the open menu: attack skills after a right
+        Skill2,         // attack call, defense skills after a right defense call
+        Skill3
+    };
+
+    // What the enemy does when its attack comes round. The AI declares it at
+    // each coin call (setEnemyMove); it is spent with the attack and falls
+    // back to Attack, which is all an enemy without an AI ever does
+    enum class EnemyMove : std::uint8_t {
+        Attack,
+        PowerStrike,    // Harder hit for MP
+        Guard           // No hit; takes GuardReduction of the damage until its next move
+    };
+
+    // Who the player faces; stats come from the BASE_ENEMY_* / BASE_BOSS_* constants
+    enum class Encounter : std::uint8_t {
+        Chalamander,
+        Bisasam,
+        Boss
+    };
+
+    // The base stats encounters are built from: the constants by default,
+    // other values when the balance tool tries them
+    struct EncounterStats {
+        int enemyHp = Constants::BASE_ENEMY_HP;
+        int enemyMp = Constants::BASE_ENEMY_MP;
+        int enemyAtk = Constants::BASE_ENEMY_ATK;
+        int enemyDef = Constants::BASE_ENEMY_DEF;
+        int bossHp = Constants::BASE_BOSS_HP;
+        int bossMp = Constants::BASE_BOSS_MP;
+        int bossAtk = Constants::BASE_BOSS_ATK;
+        int bossDef = Constants::BASE_BOSS_DEF;
+    };
+
+    struct Fighter {
+        int hp;
+        int maxHp;
+        int atk;
+        int def;
+        int mp;             // Only the enemy spends it, on its moves
+        StatusSet status;
+    };
+
+    struct State {
+        Fighter player;
+        Fighter enemy;
+        Phase phase;
+        bool defending;     // The next call defends against the enemy's attack
+        bool skillMenu;     // A right call opened the skills of the current side
+        bool coinHead;      // How the last coin landed
+        bool coinCorrect;   // Whether it matched the call
+        EnemyMove enemyMove;    // Declared for the enemy's next attack
+    };
+
+    // What a step did, in order, for presentation
+    struct Event {
+        enum Type : std::uint8_t {
+            CoinLanded,
+            NormalAttack,       // Wrong attack call: plain hit
+            Strike,             // Attack action; skill is 1 when doubled by a right call
+            SkillAttack,
+            Recoil,
+            EnemyStunned,
+            EnemyLostTurn,
+            EnemyTurn,
+            DefenseCallRight,
+            DefenseCallWrong,
+            EnemyDodged,
+            EnemyAttack,
+            DefenseSkill,
+            PlayerDamaged,
+            Victory,
+            Defeat,
+            EnemyPowerStrike,   // Before the EnemyAttack / PlayerDamaged it powers
+            EnemyGuard
+        } type;
+        std::uint8_t skill;     // PikaAtkSkill / PikaDefSkill for skill events
+        int amount;             // Damage dealt or taken
+    };
+
+    static constexpr std::size_t MaxEvents = 8;
+
+    // Percent rolls are rollRange(1, 100) <= chance. Every other roll picks
+    // among a few values compared for equality (the coin), which is what lets
+    // CombatSolver enumerate the outcomes of a step exactly
+    static constexpr int StunChance = 20;       // Thunderbolt
+    static constexpr int DodgeChance = static_cast<int>(Constants::MONSTER_DODGE_CHANCE * 100);    // On a wrong defense call
+    static constexpr std::array<int, 2> ChanceThresholds = {StunChance, DodgeChance};
+
+    // Enemy move costs and power: the Power Strike and Guard skills' constants
+    static constexpr int PowerStrikeCost = Constants::POWER_STRIKE_MP_COST;
+    static constexpr float PowerStrikeMultiplier = Constants::POWER_STRIKE_MULTIPLIER;
+    static constexpr int GuardCost = Constants::GUARD_MP_COST;
+    static constexpr float GuardReduction = Constants::GUARD_DAMAGE_TAKEN;
+
+    struct StepResult {
+        bool accepted;          // False when the action does not apply in this state
+        std::uint8_t eventCount;
+        std::array<Event, MaxEvents> events;
+    };
+
+    // One way a step can turn out
+    struct Outcome {
+        State state;
+        double probability;
+    };
+
+    static constexpr std::size_t MaxOutcomes = 16;
+    using Outcomes = std::array<Outcome, MaxOutcomes>;
+
+public:
+    CombatEngine();
+    explicit CombatEngine(const State& state);
+
+    // Pikachu 100 HP / 15 ATK / 10 DEF against an 80 / 12 / 8 enemy
+    static State makeDefaultState();
+    // The same Pikachu against a map monster or the boss
+    static State makeEncounterState(Encounter encounter);
+    static State makeEncounterState(Encounter encounter, const EncounterStats& stats);
+
+    void reset(const State& state);
+    void reset() { reset(makeDefaultState()); }
+
+    template <typename Rng>
+    StepResult step(Action action, Rng& rng);
+
+    bool canStep(Action action) const;
+
+    // Every result of stepping state with action and the chance of each, found
+    // by replaying the step with scripted rolls. Returns how many were written
+    static std::size_t enumerateOutcomes(const State& state, Action action, Outcomes& outcomes);
+
+    bool canUseEnemyMove(EnemyMove move) const;
+    // False, leaving the declared move alone, when the enemy cannot pay for it
+    bool setEnemyMove(EnemyMove move);
+
+    // Everything the rules read except the fixed fighter stats, packed into 64
+    // bits (HP below 1024, enemy MP below 128). Bit 63 is left to the caller
+    static std::uint64_t packKey(const State& state);
+    // Same max HP, ATK and DEF on both sides
+    static bool sameStats(const State& a, const State& b);
+
+    // Debug shortcut: ends the battle without touching the fighters
+    void forceResult(bool victory);
+
+    const State& getState() const { return m_state; }
+    bool isOver() const { return m_state.phase == Phase::Victory || m_state.phase == Phase::Defeat; }
+
+private:
+    template <typename Rng>
+    void resolveCall(bool head, Rng& rng, StepResult& result);
+    template <typename Rng>
+    void applyAttackSkill(PikaAtkSkill skill, Rng& rng, StepResult& result);
+
+    void applyDefenseSkill(PikaDefSkill skill, StepResult& result);
+    void strike(StepResult& result);
+    void enemyAttack(StepResult& result);
+    void beginEnemyTurn(StepResult& result);
+    // Spends the declared move; returns the damage of the hit (0 for Guard)
+    int resolveEnemyMove(StepResult& result);
+    void checkEnd(StepResult& result);
+
+    static void emit(StepResult& result, Event::Type type, int amount = 0, std::uint8_t skill = 0);
+
+private:
+    State m_state;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include "core/CombatEngine.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// One combat log line as plain data: what happened, to whom and what both
+// fighters were left with. CombatState formats entries into text only when
+// the log is on screen.
+struct CombatLogEntry {
+    enum Actor : std::uint8_t { System, Player, Enemy };
+
+    enum Flags : std::uint8_t {
+        Crit = 1 << 0,          // A strike doubled by a right coin call
+        Dodged = 1 << 1,        // The attack missed
+        Defending = 1 << 2      // Logged during the enemy's turn
+    };
+
+    // Kinds past the engine's Event::Type values, for lines only the presenter adds
+    static constexpr std::uint8_t BattleStart = 0x80;
+    static constexpr std::uint8_t Hint = 0x81;      // Carries hintAction and hintWinPercent
+
+    std::uint16_t turn;             // Player decisions before this entry
+    std::uint8_t kind;              // CombatEngine::Event::Type or one of the kinds above
+    std::uint8_t actor;
+    std::uint8_t skill;             // As CombatEngine::Event::skill
+    std::uint8_t flags;
+    std::uint8_t playerStatus;      // StatusSet bits after the step
+    std::uint8_t enemyStatus;
+    std::int16_t damage;
+    std::int16_t playerHp;          // After the step
+    std::int16_t enemyHp;
+    std::uint8_t hintAction;        // Hint only: the CombatEngine::Action advised, else 0
+    std::uint8_t hintWinPercent;    // Hint only: the solver's win chance after it, 0-100
+};
+
+static_assert(std::is_trivially_copyable_v<CombatLogEntry> && sizeof(CombatLogEntry) == 16,
+              "CombatLogEntry is exported as raw bytes");
+
+// The last Capacity entries of the current battle in a fixed ring; pushing
+// never allocates.
+//
+// Configured with -DENABLE_COMBAT_EXPORT=ON, the log also keeps every entry
+// of the battle and appendBattle() writes them to a binary file for offline
+// analysis; otherwise none of that is compiled in.
+//
+// Export layout: "EOCL" | u16 version (2), once per file, then per battle:
+//   u32 session | u8 monster | u8 result | u16 reserved | u32 entry count |
+//   entries as raw CombatLogEntry (host byte order, little-endian on every
+//   platform the game builds for). Version 1 files held hint entries'
+//   action in skill and win percent in damage; appendBattle() will not add
+//   to a file of another version
+class CombatLog {
+public:
+    static constexpr std::size_t Capacity = 64;
+
+public:
+    CombatLog();
+
+    void clear();
+
+    // One entry per engine event of a step, stamped with the state after it
+    void pushStep(const CombatEngine::StepResult& result, const CombatEngine::State& after);
+    void push(const CombatLogEntry& entry);
+
+    std::size_t size() const { return m_count; }
+    // 0 is the newest entry
+    const CombatLogEntry& fromNewest(std::size_t index) const;
+
+    // Entries pushed since clear(); tells a reader whether the log changed
+    std::uint64_t getTotal() const { return m_total; }
+    std::uint16_t getTurn() const { return m_turn; }
+
+    static CombatLogEntry makeEntry(std::uint8_t kind, const CombatEngine::State& state);
+
+#ifdef ENABLE_COMBAT_EXPORT
+    const std::vector<CombatLogEntry>& getBattle() const { return m_battle; }
+    bool appendBattle(const std::string& filename, std::uint32_t session, std::uint8_t monster,
+                      std::uint8_t result) const;
+#endif
+
+private:
+    std::array<CombatLogEntry, Capacity> m_entries;
+    std::size_t m_next;         // Ring index the next entry goes to
+    std::size_t m_count;
+    std::uint64_t m_total;
+    std::uint16_t m_turn;
+
+#ifdef ENABLE_COMBAT_EXPORT
+    std::vector<CombatLogEntry> m_battle;
+#endif
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "core/CombatEngine.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Expectimax over CombatEngine states for the enemy's declared move. The
+// enemy minimises the player's chance to win, the player is modelled as
+// anywhere between the best player and a random one, and the rolls are
+// averaged; positions past the search horizon are scored by how many hits
+// each side still needs.
+//
+// Iterative deepening, one player decision per ply, until the node budget or
+// the hard time limit runs out; only fully searched depths count. A
+// transposition table keyed on CombatEngine::packKey carries values from one
+// iteration (and one decision) to the next.
+class CombatSearch {
+public:
+    struct Limits {
+        int maxDepth = 16;                          // Player decisions ahead
+        std::uint64_t maxNodes = 0;                 // 0 for no node budget
+        std::chrono::microseconds timeLimit{0};     // 0 for no time limit
+    };
+
+    struct Result {
+        CombatEngine::EnemyMove move;
+        double playerWinChance;     // As the deepest finished search sees it
+        int depth;                  // Deepest finished iteration
+        std::uint64_t nodes;
+        std::chrono::microseconds elapsed;
+    };
+
+public:
+    // playerSkill models the opponent: 1 always finds the best action, 0
+    // picks any action that applies; in between blends the two. The table
+    // holds 2^tableBits entries
+    explicit CombatSearch(double playerSkill = 1.0, unsigned int tableBits = 16);
+
+    // The move the enemy should declare in state, an enemy coin-call state
+    Result chooseEnemyMove(const CombatEngine::State& state, const Limits& limits);
+
+    void clearTable();
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        float value;
+        std::int8_t depth;
+        std::uint8_t move;
+    };
+
+    double enemyNode(const CombatEngine::State& state, int depth, CombatEngine::EnemyMove* bestMove);
+    double playerNode(const CombatEngine::State& state, int depth);
+    // Where an outcome goes next: the enemy declares at each coin call
+    double child(const CombatEngine::State& state, int depth);
+    bool outOfBudget();
+
+    static double evaluate(const CombatEngine::State& state);
+
+    Entry* probe(std::uint64_t key);
+
+private:
+    double m_playerSkill;
+    std::vector<Entry> m_table;
+    std::uint64_t m_mask;
+    CombatEngine::State m_stats;        // Fighter stats the table was filled for
+    bool m_hasStats;
+
+    // Per decision
+    Limits m_limits;
+    std::chrono::steady_clock::time_point m_start;
+    std::uint64_t m_nodes;
+    bool m_aborted;
+};
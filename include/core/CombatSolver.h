@@ -0,0 +1,66 @@
+#pragma once
+#include "core/CombatEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// Exact win probabilities for CombatEngine battles by memoized expectation
+// over every reachable state. Outcomes come from stepping the engine itself
+// with scripted rolls, so the solver cannot drift from the rules. A move the
+// enemy has declared is honoured; after it the enemy is taken to attack plainly.
+//
+// By default the player is assumed to play optimally. Constructed with a
+// Policy, the solver instead evaluates that policy exactly, which is how the
+// Monte Carlo tool checks its estimates. Fighter stats (max HP, ATK, DEF) are
+// fixed per solve; querying a battle with other stats starts over.
+//
+// A few choices change nothing (Agility at 0 damage returns to the same
+// coin call); such loops are solved by iterating the loop's value to a fixed
+// point rather than recursing forever.
+class CombatSolver {
+public:
+    // Chance of picking an action in a state; the weights of the actions that
+    // apply there must sum to 1
+    using Policy = std::function<double(const CombatEngine::State&, CombatEngine::Action)>;
+
+    struct Advice {
+        CombatEngine::Action action;
+        double winChance;           // After taking the action
+    };
+
+public:
+    CombatSolver();
+    explicit CombatSolver(Policy policy);
+
+    double winChance(const CombatEngine::State& state);
+
+    // Win chance after taking the action; 0 when it does not apply
+    double actionValue(const CombatEngine::State& state, CombatEngine::Action action);
+
+    // The best applicable action; ties go to the first in Action order
+    Advice advise(const CombatEngine::State& state);
+
+    std::size_t getSolvedCount() const { return m_solved.size(); }
+    void clear();
+
+private:
+    struct InProgress {
+        int depth;
+        double estimate;
+    };
+
+    void adopt(const CombatEngine::State& state);
+
+    double value(const CombatEngine::State& state, int depth, int& low);
+    double evaluate(const CombatEngine::State& state, int depth, int& low);
+    double expected(const CombatEngine::State& state, CombatEngine::Action action, int depth, int& low);
+
+private:
+    Policy m_policy;
+    CombatEngine m_engine;
+    CombatEngine::State m_stats;        // Fighter stats the table was built for
+    bool m_hasStats;
+    std::unordered_map<std::uint64_t, double> m_solved;
+    std::unordered_map<std::uint64_t, InProgress> m_inProgress;
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include "Types.h"
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+// Plain-data game event. Payloads are a union of trivially copyable structs,
+// so events are copied into the queue without allocating.
+struct GameEvent {
+    enum class Type : std::uint8_t {
+        CombatStarted,
+        CombatEnded,
+        TileChanged,
+        SaveRequested,
+        TurnCompleted
+    };
+
+    struct CombatStartedData {
+        MonsterType monster;
+        int x, y;                // Monster tile
+    };
+
+    struct CombatEndedData {
+        CombatResult result;
+        MonsterType monster;
+        int x, y;                // Monster tile, echoed from CombatStarted
+    };
+
+    struct TileChangedData {
+        int x, y;
+        TileType from;
+        TileType to;
+    };
+
+    Type type;
+    std::uint32_t session;       // Game session that raised the event (AnySession = broadcast)
+
+    union {
+        CombatStartedData combatStarted;
+        CombatEndedData combatEnded;
+        TileChangedData tileChanged;
+    };
+
+    // Factories
+    static GameEvent makeCombatStarted(std::uint32_t session, MonsterType monster, Vec2i pos);
+    static GameEvent makeCombatEnded(std::uint32_t session, CombatResult result, MonsterType monster, Vec2i pos);
+    static GameEvent makeTileChanged(std::uint32_t session, Vec2i pos, TileType from, TileType to);
+    static GameEvent makeSaveRequested(std::uint32_t session);
+    static GameEvent makeTurnCompleted(std::uint32_t session);
+};
+
+// Fixed-capacity event queue. Events are published during the frame and
+// delivered to subscribers once per frame by dispatch().
+class EventBus {
+public:
+    using Handler = std::function<void(const GameEvent&)>;
+    using SubscriptionID = std::uint32_t;
+
+    static constexpr std::size_t Capacity = 64;
+    static constexpr std::uint32_t AnySession = 0;
+
+public:
+    EventBus();
+
+    // Returns false (and drops the event) when the queue is full
+    bool publish(const GameEvent& event);
+
+    SubscriptionID subscribe(GameEvent::Type type, Handler handler);
+    SubscriptionID subscribeAll(Handler handler);
+    void unsubscribe(SubscriptionID id);
+
+    // Delivers the events queued before the call; events published by
+    // handlers are kept for the next frame
+    void dispatch();
+
+    // Sessions let several independent games share one bus
+    std::uint32_t newSession() { return ++m_lastSession; }
+
+    std::size_t getPendingCount() const { return m_count; }
+
+private:
+    struct Subscriber {
+        SubscriptionID id;
+        bool allTypes;
+        GameEvent::Type type;
+        Handler handler;
+    };
+
+private:
+    std::array<GameEvent, Capacity> m_queue;
+    std::size_t m_head;
+    std::size_t m_count;
+
+    // Deque so handlers can subscribe during dispatch without moving live entries
+    std::deque<Subscriber> m_subscribers;
+    SubscriptionID m_nextID;
+    std::uint32_t m_lastSession;
+    bool m_dispatching;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+// Small, fast generator for simulations that run millions of rolls (combat
+// benchmarks and analysis tools). Same rollRange() shape as RNG, so code
+// templated on the generator takes either. Not stream-compatible with RNG:
+// a seed here does not reproduce a game session.
+class FastRNG {
+public:
+    explicit FastRNG(std::uint64_t seed = 0x9E3779B97F4A7C15ull) { setSeed(seed); }
+
+    void setSeed(std::uint64_t seed) {
+        // splitmix64 spreads any seed, including 0, over the whole state
+        for (std::uint64_t& word : m_state) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    // xoshiro256+; the top bits are the strong ones
+    std::uint64_t next() {
+        std::uint64_t result = m_state[0] + m_state[3];
+        std::uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = (m_state[3] << 45) | (m_state[3] >> 19);
+        return result;
+    }
+
+    // Uniform in [min, max] by multiply-shift (bias below 2^-32 for game ranges)
+    int rollRange(int min, int max) {
+        std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min + 1);
+        return min + static_cast<int>(((next() >> 32) * span) >> 32);
+    }
+
+    bool flipCoin() { return (next() >> 63) != 0; }
+
+    // Advances by 2^128 draws. Copy a generator and jump it once per worker to
+    // hand each thread its own stream that cannot overlap the others
+    void jump() {
+        static const std::uint64_t Jump[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                             0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+        std::uint64_t s[4] = {0, 0, 0, 0};
+        for (std::uint64_t word : Jump) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (std::uint64_t(1) << bit)) {
+                    for (int i = 0; i < 4; ++i) s[i] ^= m_state[i];
+                }
+                next();
+            }
+        }
+        for (int i = 0; i < 4; ++i) m_state[i] = s[i];
+    }
+
+private:
+    std::uint64_t m_state[4];
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <SFML/Window/Event.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Compact binary input log: RNG seed, then every window event tagged with the
+// fixed-step tick it was processed on, plus periodic state hash checkpoints.
+//
+// Layout: "EOCR" | u16 version | u32 seed | records...
+// Record: u8 kind | varint tick delta | payload
+//   Event:      u8 sf::Event::EventType + type-specific varints
+//   Checkpoint: u64 state hash
+//   End:        (no payload, marks the last tick)
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool open(const std::string& filename, std::uint32_t seed);
+    void close(std::uint64_t finalTick);
+    bool isOpen() const { return m_file.is_open(); }
+
+    void recordEvent(std::uint64_t tick, const sf::Event& event);
+    void recordCheckpoint(std::uint64_t tick, std::uint64_t stateHash);
+
+private:
+    void writeRecord(std::uint8_t kind, std::uint64_t tick);
+    void writeVarint(std::uint64_t value);
+    void writeSigned(std::int64_t value);
+
+private:
+    std::ofstream m_file;
+    std::uint64_t m_lastTick;
+};
+
+// Reads a log written by InputRecorder and hands events back tick by tick
+class InputPlayer {
+public:
+    struct Checkpoint {
+        std::uint64_t tick;
+        std::uint64_t stateHash;
+    };
+
+public:
+    InputPlayer();
+
+    bool open(const std::string& filename);
+    bool isOpen() const { return m_loaded; }
+
+    std::uint32_t getSeed() const { return m_seed; }
+    std::uint64_t getFinalTick() const { return m_finalTick; }
+    std::size_t getEventCount() const { return m_events.size(); }
+
+    // Pops the next event recorded for this tick; false once the tick is drained
+    bool pollEvent(std::uint64_t tick, sf::Event& event);
+
+    // Returns true and the recorded hash if a checkpoint was taken after this tick
+    bool checkpointAt(std::uint64_t tick, std::uint64_t& stateHash);
+
+    bool isFinished(std::uint64_t tick) const { return tick >= m_finalTick; }
+
+private:
+    struct TimedEvent {
+        std::uint64_t tick;
+        sf::Event event;
+    };
+
+    bool readVarint(std::uint64_t& value);
+    bool readSigned(std::int64_t& value);
+    bool readEvent(sf::Event& event);
+
+private:
+    std::vector<std::uint8_t> m_data;
+    std::size_t m_cursor;
+
+    std::vector<TimedEvent> m_events;
+    std::vector<Checkpoint> m_checkpoints;
+    std::size_t m_nextEvent;
+    std::size_t m_nextCheckpoint;
+
+    std::uint32_t m_seed;
+    std::uint64_t m_finalTick;
+    bool m_loaded;
+};
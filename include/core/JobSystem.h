@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops its
+// own work at the back and steals from the front of the others when idle.
+// Threads that are not workers (the main thread) hand work out round-robin.
+//
+// Jobs can depend on earlier jobs, which makes small task graphs; waiting on a
+// job runs other queued work instead of blocking. Results that must touch game
+// state go through postToMainThread and run in pumpMainThread (Game::update).
+class JobSystem {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct JobNode;
+
+public:
+    // Completion token for a scheduled job; empty handles count as finished
+    class JobHandle {
+    public:
+        JobHandle() = default;
+        bool isDone() const;
+
+    private:
+        friend class JobSystem;
+        explicit JobHandle(std::shared_ptr<JobNode> node) : m_node(std::move(node)) {}
+        std::shared_ptr<JobNode> m_node;
+    };
+
+public:
+    // 0 workers means one per hardware thread, minus the main thread
+    explicit JobSystem(std::size_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    std::size_t getWorkerCount() const { return m_workers.size(); }
+
+    // Runs the task once every dependency has finished
+    JobHandle schedule(Task task, const std::vector<JobHandle>& dependencies = {});
+
+    // Blocks until the job is done, running queued work in the meantime
+    void wait(const JobHandle& job);
+    void wait(const std::vector<JobHandle>& jobs);
+
+    // Calls body(begin, end) over [0, count) in chunks of at most grain items.
+    // The calling thread takes part and returns when every chunk is done.
+    void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+
+    // Runs work on a worker; the future is ready once it returns
+    template <typename F>
+    auto async(F&& work) -> std::future<decltype(work())>;
+
+    // Runs work on a worker, then hands its result to onComplete on the main
+    // thread during the next pumpMainThread. The result must be copyable.
+    template <typename F, typename Then>
+    JobHandle asyncThen(F&& work, Then&& onComplete);
+
+    // Main-thread continuation queue, drained once per fixed update
+    void postToMainThread(Task task);
+    std::size_t pumpMainThread();
+
+private:
+    struct JobNode {
+        Task task;
+        std::atomic<int> pendingDependencies{1};
+        std::atomic<bool> done{false};
+
+        std::mutex mutex;             // Guards finished and dependents
+        bool finished = false;
+        std::vector<std::shared_ptr<JobNode>> dependents;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<JobNode>> jobs;
+    };
+
+    void workerLoop(std::size_t index);
+    void enqueue(std::shared_ptr<JobNode> job);
+    std::shared_ptr<JobNode> takeJob(std::size_t preferredQueue);
+    bool tryRunOne();
+    void execute(const std::shared_ptr<JobNode>& job);
+    std::size_t currentWorkerIndex() const;
+
+private:
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<std::size_t> m_nextQueue;
+
+    // Sleep/wake for idle workers; m_queued counts jobs sitting in any deque
+    std::atomic<std::size_t> m_queued;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_stopping;
+
+    std::mutex m_mainMutex;
+    std::vector<Task> m_mainQueue;
+};
+
+template <typename F>
+auto JobSystem::async(F&& work) -> std::future<decltype(work())> {
+    using Result = decltype(work());
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(work));
+    std::future<Result> future = task->get_future();
+    schedule([task]() { (*task)(); });
+    return future;
+}
+
+template <typename F, typename Then>
+JobSystem::JobHandle JobSystem::asyncThen(F&& work, Then&& onComplete) {
+    return schedule([this, work = std::forward<F>(work), onComplete = std::forward<Then>(onComplete)]() {
+        auto result = work();
+        postToMainThread([onComplete, result]() { onComplete(result); });
+    });
+}
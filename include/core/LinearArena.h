@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+// Bump allocator for short-lived data, usable with any std::pmr container:
+//
+//     std::pmr::vector<Vec2i> open(&LinearArena::frame());
+//
+// Allocating moves a pointer; deallocating does nothing and reset() drops
+// everything at once. When the block runs out the arena borrows chunks from
+// its upstream resource; an arena that owns its block regrows it to the
+// high-water mark on the next reset, so a steady workload stops overflowing
+// after its first frame.
+class LinearArena : public std::pmr::memory_resource {
+public:
+    // Owns a block of the given size, taken from upstream
+    explicit LinearArena(std::size_t capacity,
+                         std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    // Bumps through a caller-provided buffer (stack scratch space); never regrows it
+    LinearArena(void* buffer, std::size_t size,
+                std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // Invalidates everything allocated since the last reset
+    void reset();
+
+    std::size_t getUsed() const { return m_used + m_overflowBytes; }
+    std::size_t getCapacity() const { return m_capacity; }
+    std::size_t getHighWater() const { return m_highWater; }
+    std::size_t getOverflowCount() const { return m_overflowCount; }   // Upstream chunks taken, ever
+
+    // The calling thread's frame arena. The loop that owns the thread resets
+    // it once per frame (or tick), so nothing from it may be kept across one.
+    static LinearArena& frame();
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    // Header of a block borrowed from upstream after the main one filled up
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;
+    };
+
+    void releaseChunks();
+
+private:
+    std::pmr::memory_resource* m_upstream;
+    std::byte* m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_used;
+    bool m_ownsBuffer;
+
+    Chunk* m_chunks;                // Newest first; the head is the one being bumped
+    std::size_t m_chunkUsed;
+    std::size_t m_overflowBytes;    // Handed out from chunks since the last reset
+
+    std::size_t m_highWater;
+    std::size_t m_overflowCount;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped-zone instrumentation. Configure with -DENABLE_PROFILER=ON to record;
+// otherwise the macros expand to nothing.
+#ifdef ENABLE_PROFILER
+    #define PROFILE_CONCAT_INNER(a, b) a##b
+    #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+    #define PROFILE_SCOPE(name) Profiler::Zone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#else
+    #define PROFILE_SCOPE(name) ((void)0)
+    #define PROFILE_FUNCTION() ((void)0)
+#endif
+
+class Profiler {
+public:
+    // Records one complete event from construction to destruction.
+    // The name must outlive the profiler (string literals, __func__).
+    class Zone {
+    public:
+        explicit Zone(const char* name);
+        ~Zone();
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* m_name;
+        std::int64_t m_start;
+    };
+
+public:
+    static Profiler& instance();
+
+    // Appends to the calling thread's buffer; no locks on this path
+    void record(const char* name, std::int64_t startUs, std::int64_t endUs);
+
+    // Writes every event recorded so far as Chrome/Perfetto trace JSON
+    bool exportChromeTrace(const std::string& filename) const;
+
+    std::int64_t nowMicroseconds() const;
+
+private:
+    static constexpr std::size_t BlockSize = 4096;
+    static constexpr std::size_t MaxBlocksPerThread = 256;
+
+    struct Event {
+        const char* name;
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    // Single-writer block: the owning thread publishes count with release,
+    // the exporter reads it with acquire
+    struct Block {
+        std::array<Event, BlockSize> events;
+        std::atomic<std::size_t> count{0};
+        std::atomic<Block*> next{nullptr};
+    };
+
+    struct ThreadBuffer {
+        std::uint32_t threadIndex = 0;
+        std::vector<std::unique_ptr<Block>> blocks;   // Owned; only the writer appends
+        Block* head = nullptr;
+        Block* tail = nullptr;
+        std::atomic<std::size_t> dropped{0};
+    };
+
+    Profiler();
+    ThreadBuffer& localBuffer();
+
+private:
+    const std::int64_t m_epoch;
+
+    // Taken once per thread on registration and during export, never while recording
+    mutable std::mutex m_registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// What states draw into. In direct mode every call goes straight to a render
+// target (the single-threaded loop). In recording mode each drawable is copied
+// into an immutable command list that can be replayed later on another thread,
+// which is how the simulation thread hands frames to the render thread.
+class RenderList {
+public:
+    // Recording mode; call reset() before each frame
+    RenderList();
+
+    // Direct mode: forwards to target, records nothing
+    explicit RenderList(sf::RenderTarget& target);
+
+    // Drops the previous frame's commands, keeping their storage
+    void reset(const sf::Vector2u& size);
+
+    template <typename T>
+    void draw(const T& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Shares an immutable drawable instead of copying it (large cached geometry)
+    void draw(std::shared_ptr<const sf::Drawable> drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    void setView(const sf::View& view);
+    const sf::View& getDefaultView() const;
+    sf::Vector2u getSize() const;
+
+    std::size_t getCommandCount() const { return m_commands.size(); }
+
+    // Fraction of a fixed step that has elapsed since the last update. Draw
+    // code can evaluate animations this far ahead to render between ticks;
+    // recorded snapshots always use 0
+    void setInterpolation(float alpha) { m_interpolation = alpha; }
+    float getInterpolation() const { return m_interpolation; }
+
+    // Issues the recorded commands in order, then restores the default view
+    void replay(sf::RenderTarget& target) const;
+
+private:
+    struct Command {
+        std::shared_ptr<const sf::Drawable> drawable;   // Null for a view change
+        sf::RenderStates states;
+        std::size_t view;
+    };
+
+private:
+    sf::RenderTarget* m_target;
+    sf::Vector2u m_size;
+    sf::View m_defaultView;
+    float m_interpolation;
+    std::vector<Command> m_commands;
+    std::vector<sf::View> m_views;
+};
+
+template <typename T>
+void RenderList::draw(const T& drawable, const sf::RenderStates& states) {
+    if (m_target) {
+        m_target->draw(drawable, states);
+        return;
+    }
+
+    // sf::Text lays out its glyphs lazily; do it here so the copy carries the
+    // finished geometry and replaying never touches the font's glyph tables
+    if constexpr (std::is_base_of<sf::Text, T>::value) {
+        drawable.getLocalBounds();
+    }
+    m_commands.push_back(Command{std::make_shared<const T>(drawable), states, 0});
+}
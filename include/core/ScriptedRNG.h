@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+// Replays a fixed list of roll results instead of drawing them. CombatSolver
+// steps the engine once per script to walk every outcome of an action: when
+// the engine asks for a roll past the end of the script, the range is recorded
+// so the caller can extend the script with each value it cares about.
+class ScriptedRNG {
+public:
+    static constexpr std::size_t MaxRolls = 4;
+
+    ScriptedRNG(const std::array<int, MaxRolls>& rolls, std::size_t count)
+        : m_rolls(rolls)
+        , m_count(count)
+        , m_used(0)
+        , m_exhausted(false)
+        , m_pendingMin(0)
+        , m_pendingMax(0)
+    {
+    }
+
+    int rollRange(int min, int max) {
+        if (m_used < m_count) {
+            return m_rolls[m_used++];
+        }
+        if (!m_exhausted) {
+            m_exhausted = true;
+            m_pendingMin = min;
+            m_pendingMax = max;
+        }
+        ++m_used;
+        return min;
+    }
+
+    // The step asked for more rolls than scripted; its result is meaningless
+    bool isExhausted() const { return m_exhausted; }
+    int getPendingMin() const { return m_pendingMin; }
+    int getPendingMax() const { return m_pendingMax; }
+
+private:
+    std::array<int, MaxRolls> m_rolls;
+    std::size_t m_count;
+    std::size_t m_used;
+    bool m_exhausted;
+    int m_pendingMin;
+    int m_pendingMax;
+};
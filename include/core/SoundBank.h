@@ -0,0 +1,83 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// Owns every sound effect buffer. Effects listed in the manifest are loaded
+// up front on the job system's workers so the first play never touches the disk.
+class SoundBank {
+public:
+    using Handle = std::size_t;
+    static constexpr Handle InvalidHandle = static_cast<Handle>(-1);
+
+    // Decoded: PCM stays resident (more memory, zero decode on play)
+    // Compressed: encoded bytes stay resident, PCM is decoded into a small cache on demand
+    enum class Storage {
+        Decoded,
+        Compressed
+    };
+
+    // Returns true while a buffer is attached to a playing voice (never evicted)
+    using InUseQuery = std::function<bool(const sf::SoundBuffer&)>;
+
+public:
+    SoundBank();
+
+    // Loads every file in the manifest in parallel; returns false if any failed
+    bool loadManifest(const std::vector<std::string>& filenames, Storage storage, JobSystem& jobs);
+
+    // Lazy fallback for effects missing from the manifest (decodes on the calling thread)
+    Handle load(const std::string& filename);
+
+    // Returns a playable buffer, decoding compressed entries into the cache if needed
+    const sf::SoundBuffer* acquire(Handle handle);
+
+    std::size_t getSize() const { return m_entries.size(); }
+
+    // Cache control for compressed entries
+    void setCacheCapacity(std::size_t capacity);
+    void setInUseQuery(InUseQuery query) { m_inUse = std::move(query); }
+
+    // Memory report
+    std::size_t getDecodedBytes() const;
+    std::size_t getCompressedBytes() const;
+
+private:
+    struct Entry {
+        std::string filename;
+        Storage storage = Storage::Decoded;
+        std::vector<char> encoded;     // Compressed storage only
+        sf::SoundBuffer buffer;
+        bool decoded = false;
+        std::uint64_t lastUsed = 0;
+    };
+
+    // Produced by the workers; turned into sf::SoundBuffer on the main thread
+    struct DecodeJob {
+        std::string filename;
+        std::vector<sf::Int16> samples;
+        std::vector<char> encoded;
+        unsigned int channelCount = 0;
+        unsigned int sampleRate = 0;
+        bool ok = false;
+    };
+
+    static void decodeFile(DecodeJob& job, Storage storage);
+    bool decodeEntry(Entry& entry);
+    void evictFor(const Entry& incoming);
+
+private:
+    // Deque keeps buffer addresses stable for attached sf::Sound voices
+    std::deque<Entry> m_entries;
+    std::map<std::string, Handle> m_handles;
+
+    std::size_t m_cacheCapacity;
+    std::uint64_t m_useCounter;
+    InUseQuery m_inUse;
+};
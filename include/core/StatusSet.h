@@ -0,0 +1,87 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// The status effects on one fighter. Effects of different types are active
+// together: a bit per type says which are on, and the duration and magnitude
+// of each sit in small arrays indexed by type. Seven bytes, trivially
+// copyable and never allocating, so engine states carrying two of them are
+// still cheap for simulations and search to snapshot.
+//
+// Durations count the holder's turns: the engine calls tick() once as each
+// of the holder's turns starts, after the effects that act then (a stun
+// costing the turn) have been read. What an effect does lives in the combat
+// rules; the set only keeps the numbers. The engine steps through these on
+// every search node, so they are defined here where the compiler can inline
+// them.
+class StatusSet {
+public:
+    enum Type : std::uint8_t {
+        Stun,           // Loses its next turn
+        ATKBonus,       // Magnitude added to the next attack, then spent
+        Guard,          // Takes reduced damage until its next move
+        Count
+    };
+
+    // Duration of an effect that stays until the rules spend it
+    static constexpr std::uint8_t UntilUsed = 0xFF;
+
+public:
+    StatusSet() : m_durations(), m_magnitudes(), m_active(0) {}
+
+    // Re-applying an active effect refreshes it: it keeps the longer
+    // duration and the larger magnitude
+    void apply(Type type, std::uint8_t duration, std::uint8_t magnitude = 0) {
+        if (duration == 0) return;
+
+        if (has(type)) {
+            m_durations[type] = std::max(m_durations[type], duration);
+            m_magnitudes[type] = std::max(m_magnitudes[type], magnitude);
+        } else {
+            m_durations[type] = duration;
+            m_magnitudes[type] = magnitude;
+            m_active |= bit(type);
+        }
+    }
+    void remove(Type type) { m_active &= static_cast<std::uint8_t>(~bit(type)); }
+    void clear() { m_active = 0; }
+
+    // Removes the effect; returns its magnitude, 0 when it was not active
+    int consume(Type type) {
+        int magnitude = getMagnitude(type);
+        remove(type);
+        return magnitude;
+    }
+
+    // One of the holder's turns started: timed effects count down and the
+    // ones that run out are removed
+    void tick() {
+        for (std::uint8_t active = m_active; active != 0; active &= active - 1) {
+            Type type = static_cast<Type>(std::countr_zero(active));
+            std::uint8_t& duration = m_durations[type];
+            if (duration != UntilUsed && --duration == 0) {
+                remove(type);
+            }
+        }
+    }
+
+    bool has(Type type) const { return (m_active & bit(type)) != 0; }
+    bool any() const { return m_active != 0; }
+    std::uint8_t getActive() const { return m_active; }
+    std::uint8_t getDuration(Type type) const { return has(type) ? m_durations[type] : 0; }
+    std::uint8_t getMagnitude(Type type) const { return has(type) ? m_magnitudes[type] : 0; }
+
+    // Every active effect with its duration and magnitude, 8 bits each
+    std::uint64_t pack() const;
+
+private:
+    static constexpr std::uint8_t bit(Type type) { return static_cast<std::uint8_t>(1u << type); }
+
+private:
+    std::array<std::uint8_t, Count> m_durations;
+    std::array<std::uint8_t, Count> m_magnitudes;
+    std::uint8_t m_active;
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Coroutine scheduler on the game clock. Timed flows are written straight
+// through instead of as switch-and-accumulator state machines:
+//
+//     TaskScheduler::Task CombatState::flipCoin() {
+//         co_await m_tasks.wait(m_coinDuration);
+//         ...
+//     }
+//
+// The clock only moves in advance(), so tasks follow fixed steps, pauses and
+// time scaling exactly like the state that owns the scheduler. Sleeping tasks
+// sit in a wake-time heap and cost nothing until they are due.
+class TaskScheduler {
+public:
+    using TaskID = std::uint64_t;
+
+    // Coroutine return type. Hand it to spawn(); a task that is never spawned
+    // never runs.
+    class Task {
+    public:
+        struct promise_type {
+            TaskID id = 0;
+            bool cancelled = false;    // Cancelled while running: destroyed at its next suspension
+
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+        Task& operator=(Task&& other) noexcept;
+        ~Task();
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+    private:
+        friend class TaskScheduler;
+        explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    using Handle = std::coroutine_handle<Task::promise_type>;
+
+    // co_await wait(duration): resumes in the first advance() that reaches it
+    struct WaitAwaiter {
+        TaskScheduler& scheduler;
+        sf::Time duration;
+
+        bool await_ready() const noexcept { return duration <= sf::Time::Zero; }
+        void await_suspend(Handle handle) { scheduler.sleep(handle.promise().id, duration); }
+        void await_resume() const noexcept {}
+    };
+
+    // co_await nextTick(): resumes at the end of the next advance()
+    struct TickAwaiter {
+        TaskScheduler& scheduler;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Handle handle) { scheduler.m_nextTick.push_back(handle.promise().id); }
+        void await_resume() const noexcept {}
+    };
+
+public:
+    TaskScheduler();
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Runs the task up to its first suspension and keeps it until it finishes
+    TaskID spawn(Task task);
+
+    // Destroys a task. A task cancelling itself (directly or through code it
+    // calls) keeps running until its next co_await or co_return.
+    void cancel(TaskID id);
+    void cancelAll();
+
+    // Moves the clock forward by dt, resumes every timer that came due in wake
+    // order, then every task waiting for the next tick
+    void advance(sf::Time dt);
+
+    WaitAwaiter wait(sf::Time duration) { return WaitAwaiter{*this, duration}; }
+    TickAwaiter nextTick() { return TickAwaiter{*this}; }
+
+    sf::Time now() const { return sf::microseconds(m_now); }
+    bool isRunning(TaskID id) const { return m_tasks.count(id) != 0; }
+    std::size_t getTaskCount() const { return m_tasks.size(); }
+
+private:
+    struct Timer {
+        std::int64_t wakeTime;
+        std::uint64_t sequence;    // FIFO among equal wake times
+        TaskID id;
+
+        bool operator>(const Timer& other) const {
+            return wakeTime != other.wakeTime ? wakeTime > other.wakeTime : sequence > other.sequence;
+        }
+    };
+
+    void sleep(TaskID id, sf::Time duration);
+    void resume(TaskID id);
+
+private:
+    std::int64_t m_now;             // Microseconds, like sf::Time
+    TaskID m_nextID;
+    std::uint64_t m_nextSequence;
+    TaskID m_running;               // Task being resumed, 0 outside resume()
+
+    std::unordered_map<TaskID, Handle> m_tasks;
+    // Entries of cancelled tasks stay queued and are skipped when popped
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;
+    std::vector<TaskID> m_nextTick;
+    std::vector<TaskID> m_ticking;  // This advance's share of m_nextTick
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer triple buffer. The writer fills
+// its back slot and publishes it; the reader always gets the newest published
+// slot. Neither side ever waits and intermediate frames are simply dropped.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : m_back(0)
+        , m_middle(1)
+        , m_front(2)
+    {
+    }
+
+    // Writer side
+    T& writeBuffer() { return m_buffers[m_back]; }
+
+    void publish() {
+        m_back = m_middle.exchange(static_cast<std::uint8_t>(m_back | Fresh), std::memory_order_acq_rel) & IndexMask;
+    }
+
+    // Reader side: swaps in the newest slot, false if nothing was published since
+    bool consume() {
+        if (!(m_middle.load(std::memory_order_relaxed) & Fresh)) {
+            return false;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    const T& readBuffer() const { return m_buffers[m_front]; }
+
+private:
+    static constexpr std::uint8_t IndexMask = 0x3;
+    static constexpr std::uint8_t Fresh = 0x4;
+
+    std::array<T, 3> m_buffers;
+    std::uint8_t m_back;                // Writer-owned
+    std::atomic<std::uint8_t> m_middle; // Shared slot index plus Fresh flag
+    std::uint8_t m_front;               // Reader-owned
+};
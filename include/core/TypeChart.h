@@ -0,0 +1,159 @@
+#pragma once
+#include "Constants.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Fire, Water and Grass keep their original values; saves store the type as
+// an integer
+enum class PokemonType : std::uint8_t {
+    Fire,
+    Water,
+    Grass,
+    Normal,
+    Electric,
+    Ice,
+    Fighting,
+    Poison,
+    Ground,
+    Flying,
+    Psychic,
+    Bug,
+    Rock,
+    Ghost,
+    Dragon,
+    Dark,
+    Steel,
+    Fairy
+};
+
+// Type effectiveness as one Count x Count matrix, attacker-major, generated
+// at compile time from the list of matchups that are not neutral. Plain C++
+// like CombatEngine, so the simulators and AI can use it without SFML.
+namespace TypeChart {
+    constexpr std::size_t Count = static_cast<std::size_t>(PokemonType::Fairy) + 1;
+
+    using Matrix = std::array<float, Count * Count>;
+
+    struct Matchup {
+        PokemonType attacker;
+        PokemonType defender;
+        float multiplier;
+    };
+
+    namespace Detail {
+        using T = PokemonType;
+        constexpr float Super = Constants::TYPE_SUPER_EFFECTIVE;
+        constexpr float Resisted = Constants::TYPE_NOT_VERY_EFFECTIVE;
+        constexpr float Immune = Constants::TYPE_NO_EFFECT;
+
+        inline constexpr Matchup Matchups[] = {
+            {T::Normal, T::Rock, Resisted}, {T::Normal, T::Steel, Resisted}, {T::Normal, T::Ghost, Immune},
+
+            {T::Fire, T::Grass, Super}, {T::Fire, T::Ice, Super}, {T::Fire, T::Bug, Super},
+            {T::Fire, T::Steel, Super}, {T::Fire, T::Fire, Resisted}, {T::Fire, T::Water, Resisted},
+            {T::Fire, T::Rock, Resisted}, {T::Fire, T::Dragon, Resisted},
+
+            {T::Water, T::Fire, Super}, {T::Water, T::Ground, Super}, {T::Water, T::Rock, Super},
+            {T::Water, T::Water, Resisted}, {T::Water, T::Grass, Resisted}, {T::Water, T::Dragon, Resisted},
+
+            {T::Electric, T::Water, Super}, {T::Electric, T::Flying, Super},
+            {T::Electric, T::Electric, Resisted}, {T::Electric, T::Grass, Resisted},
+            {T::Electric, T::Dragon, Resisted}, {T::Electric, T::Ground, Immune},
+
+            {T::Grass, T::Water, Super}, {T::Grass, T::Ground, Super}, {T::Grass, T::Rock, Super},
+            {T::Grass, T::Fire, Resisted}, {T::Grass, T::Grass, Resisted}, {T::Grass, T::Poison, Resisted},
+            {T::Grass, T::Flying, Resisted}, {T::Grass, T::Bug, Resisted}, {T::Grass, T::Dragon, Resisted},
+            {T::Grass, T::Steel, Resisted},
+
+            {T::Ice, T::Grass, Super}, {T::Ice, T::Ground, Super}, {T::Ice, T::Flying, Super},
+            {T::Ice, T::Dragon, Super}, {T::Ice, T::Fire, Resisted}, {T::Ice, T::Water, Resisted},
+            {T::Ice, T::Ice, Resisted}, {T::Ice, T::Steel, Resisted},
+
+            {T::Fighting, T::Normal, Super}, {T::Fighting, T::Ice, Super}, {T::Fighting, T::Rock, Super},
+            {T::Fighting, T::Dark, Super}, {T::Fighting, T::Steel, Super}, {T::Fighting, T::Poison, Resisted},
+            {T::Fighting, T::Flying, Resisted}, {T::Fighting, T::Psychic, Resisted},
+            {T::Fighting, T::Bug, Resisted}, {T::Fighting, T::Fairy, Resisted}, {T::Fighting, T::Ghost, Immune},
+
+            {T::Poison, T::Grass, Super}, {T::Poison, T::Fairy, Super}, {T::Poison, T::Poison, Resisted},
+            {T::Poison, T::Ground, Resisted}, {T::Poison, T::Rock, Resisted}, {T::Poison, T::Ghost, Resisted},
+            {T::Poison, T::Steel, Immune},
+
+            {T::Ground, T::Fire, Super}, {T::Ground, T::Electric, Super}, {T::Ground, T::Poison, Super},
+            {T::Ground, T::Rock, Super}, {T::Ground, T::Steel, Super}, {T::Ground, T::Grass, Resisted},
+            {T::Ground, T::Bug, Resisted}, {T::Ground, T::Flying, Immune},
+
+            {T::Flying, T::Grass, Super}, {T::Flying, T::Fighting, Super}, {T::Flying, T::Bug, Super},
+            {T::Flying, T::Electric, Resisted}, {T::Flying, T::Rock, Resisted}, {T::Flying, T::Steel, Resisted},
+
+            {T::Psychic, T::Fighting, Super}, {T::Psychic, T::Poison, Super},
+            {T::Psychic, T::Psychic, Resisted}, {T::Psychic, T::Steel, Resisted}, {T::Psychic, T::Dark, Immune},
+
+            {T::Bug, T::Grass, Super}, {T::Bug, T::Psychic, Super}, {T::Bug, T::Dark, Super},
+            {T::Bug, T::Fire, Resisted}, {T::Bug, T::Fighting, Resisted}, {T::Bug, T::Poison, Resisted},
+            {T::Bug, T::Flying, Resisted}, {T::Bug, T::Ghost, Resisted}, {T::Bug, T::Steel, Resisted},
+            {T::Bug, T::Fairy, Resisted},
+
+            {T::Rock, T::Fire, Super}, {T::Rock, T::Ice, Super}, {T::Rock, T::Flying, Super},
+            {T::Rock, T::Bug, Super}, {T::Rock, T::Fighting, Resisted}, {T::Rock, T::Ground, Resisted},
+            {T::Rock, T::Steel, Resisted},
+
+            {T::Ghost, T::Psychic, Super}, {T::Ghost, T::Ghost, Super}, {T::Ghost, T::Dark, Resisted},
+            {T::Ghost, T::Normal, Immune},
+
+            {T::Dragon, T::Dragon, Super}, {T::Dragon, T::Steel, Resisted}, {T::Dragon, T::Fairy, Immune},
+
+            {T::Dark, T::Psychic, Super}, {T::Dark, T::Ghost, Super}, {T::Dark, T::Fighting, Resisted},
+            {T::Dark, T::Dark, Resisted}, {T::Dark, T::Fairy, Resisted},
+
+            {T::Steel, T::Ice, Super}, {T::Steel, T::Rock, Super}, {T::Steel, T::Fairy, Super},
+            {T::Steel, T::Fire, Resisted}, {T::Steel, T::Water, Resisted}, {T::Steel, T::Electric, Resisted},
+            {T::Steel, T::Steel, Resisted},
+
+            {T::Fairy, T::Fighting, Super}, {T::Fairy, T::Dragon, Super}, {T::Fairy, T::Dark, Super},
+            {T::Fairy, T::Fire, Resisted}, {T::Fairy, T::Poison, Resisted}, {T::Fairy, T::Steel, Resisted}
+        };
+
+        constexpr std::size_t index(PokemonType attacker, PokemonType defender) {
+            return static_cast<std::size_t>(attacker) * Count + static_cast<std::size_t>(defender);
+        }
+
+        constexpr Matrix build() {
+            Matrix matrix{};
+            for (float& cell : matrix) cell = Constants::TYPE_NORMAL_EFFECTIVE;
+            for (const Matchup& matchup : Matchups) {
+                matrix[index(matchup.attacker, matchup.defender)] = matchup.multiplier;
+            }
+            return matrix;
+        }
+
+        // Each pair listed once, so the matrix holds as many special cells
+        // as the list has entries
+        constexpr bool matchupsAreUnique() {
+            Matrix matrix = build();
+            std::size_t special = 0;
+            for (float cell : matrix) special += cell != Constants::TYPE_NORMAL_EFFECTIVE;
+            return special == sizeof(Matchups) / sizeof(Matchups[0]);
+        }
+    }
+
+    inline constexpr Matrix Table = Detail::build();
+    static_assert(Detail::matchupsAreUnique(), "TypeChart lists a matchup twice");
+
+    constexpr float effectiveness(PokemonType attacker, PokemonType defender) {
+        return Table[Detail::index(attacker, defender)];
+    }
+
+    // The original triangle
+    static_assert(effectiveness(PokemonType::Fire, PokemonType::Grass) == Constants::TYPE_SUPER_EFFECTIVE);
+    static_assert(effectiveness(PokemonType::Water, PokemonType::Fire) == Constants::TYPE_SUPER_EFFECTIVE);
+    static_assert(effectiveness(PokemonType::Grass, PokemonType::Water) == Constants::TYPE_SUPER_EFFECTIVE);
+    static_assert(effectiveness(PokemonType::Fire, PokemonType::Water) == Constants::TYPE_NOT_VERY_EFFECTIVE);
+
+    // out[i] = effectiveness(attackers[i], defenders[i]). Branch-free over
+    // contiguous arrays so the compiler can vectorize it
+    void effectiveness(const PokemonType* attackers, const PokemonType* defenders, float* out, std::size_t count);
+
+    // out[i] = effectiveness(attacker, defenders[i])
+    void effectiveness(PokemonType attacker, const PokemonType* defenders, float* out, std::size_t count);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Enemy.h"
+#include "core/CombatSearch.h"
 
 class Boss : public Enemy {
 public:
@@ -8,6 +9,8 @@ public:
     
     // Boss-specific behavior
     virtual CombatAction chooseAction(const Entity& target) const override;
+    // Searched within the BOSS_SEARCH_* budget
+    virtual CombatEngine::EnemyMove chooseMove(const CombatEngine::State& battle) override;
     
     // Passive abilities
     virtual int modifyIncomingDamage(int damage) const;
@@ -20,4 +23,8 @@ protected:
     
 private:
     void setupBossStats();
+
+private:
+    // Kept for the whole battle: each decision reuses the last one's table
+    CombatSearch m_search;
 };
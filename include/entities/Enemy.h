@@ -1,7 +1,7 @@
 #pragma once
 #include "Entity.h"
 #include "Skill.h"
-#include <vector>
+#include "core/CombatEngine.h"
 #include <memory>
 
 class Enemy : public Entity {
@@ -15,11 +15,13 @@ public:
     // AI behavior
     virtual CombatAction chooseAction(const Entity& target) const;
     virtual void performAction(CombatAction action, Entity& target);
+    // The move to declare for the enemy's next attack in a battle
+    virtual CombatEngine::EnemyMove chooseMove(const CombatEngine::State& battle);
     
     // Skills
-    void addSkill(std::unique_ptr<Skill> skill);
-    const std::vector<std::unique_ptr<Skill>>& getSkills() const { return m_skills; }
-    std::vector<Skill*> getAvailableSkills() const;
+    void addSkill(SkillType skillType);
+    const SkillSet& getSkills() const { return m_skills; }
+    bool canUseSkill(SkillType skillType) const;
     
     // Combat
     void normalAttack(Entity& target);
@@ -40,7 +42,7 @@ protected:
     
 protected:
     std::string m_name;
-    std::vector<std::unique_ptr<Skill>> m_skills;
+    SkillSet m_skills;
     
     // Visual representation
     sf::RectangleShape m_sprite;
@@ -1,7 +1,6 @@
 #pragma once
 #include "Entity.h"
 #include "Skill.h"
-#include <vector>
 #include <memory>
 
 class Pokemon : public Entity {
@@ -14,14 +13,13 @@ public:
     bool isEvolved() const { return m_evolved; }
     
     // Skills
-    void addSkill(std::unique_ptr<Skill> skill);
-    const std::vector<std::unique_ptr<Skill>>& getSkills() const { return m_skills; }
-    std::vector<Skill*> getAvailableSkills() const;
+    void addSkill(SkillType skillType);
+    const SkillSet& getSkills() const { return m_skills; }
     bool canUseSkill(SkillType skillType) const;
     
     // Combat
-    int calculateDamage(const Skill& skill, const Entity& target) const;
-    int calculateHealing(const Skill& skill) const;
+    int calculateDamage(SkillType skillType, const Entity& target) const;
+    int calculateHealing(SkillType skillType) const;
     void useSkill(SkillType skillType, Entity& target);
     void normalAttack(Entity& target);
     
@@ -53,7 +51,7 @@ protected:
 protected:
     std::string m_name;
     bool m_evolved;
-    std::vector<std::unique_ptr<Skill>> m_skills;
+    SkillSet m_skills;
     
     // Visual representation
     sf::RectangleShape m_sprite;
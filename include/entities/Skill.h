@@ -1,66 +1,123 @@
 #pragma once
 #include "Types.h"
-#include <string>
-#include <memory>
+#include "Constants.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// What a skill does besides damage and healing. The table only describes
+// effects; the combat code that uses a skill resolves them
+enum class SkillEffect : std::uint8_t {
+    None,
+    Stun,           // Target loses its next turn
+    Evade,          // The next incoming attack misses
+    ReduceDamage,   // Next incoming damage scaled by magnitude
+    Counter,        // Returns magnitude of the next damage taken
+    Debuff          // Target's DEF lowered by magnitude
+};
+
+struct SkillEffectData {
+    SkillEffect effect;
+    float chance;           // 0..1
+    float magnitude;
+};
+
+struct SkillInfo {
+    const char* name;
+    SkillData data;
+    SkillEffectData effect;
+};
+
+// Every skill in the game, indexed by SkillType. Looking one up is an array
+// index and entities store only SkillTypes, so nothing is allocated per skill
+namespace Skills {
+    constexpr std::size_t Count = static_cast<std::size_t>(SkillType::LeafBlade) + 1;
+
+    inline constexpr std::array<SkillInfo, Count> Table = {{
+        {"Normal Attack", SkillData(SkillType::NormalAttack, 0, 0, 1.0f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+
+        // Pikachu attack skills
+        {"Thunder Bolt", SkillData(SkillType::ThunderBolt, 15, 2, 1.8f, 0.0f, true, false, true), {SkillEffect::Stun, 0.2f, 0.0f}},
+        {"Quick Attack", SkillData(SkillType::QuickAttack, 8, 1, 1.2f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Iron Tail", SkillData(SkillType::IronTail, 12, 3, 1.6f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+
+        // Pikachu defense skills
+        {"Agility", SkillData(SkillType::Agility, 10, 2, 0.0f, 0.0f, false, true, true), {SkillEffect::Evade, 1.0f, 0.0f}},
+        {"Double Team", SkillData(SkillType::DoubleTeam, 12, 3, 0.0f, 0.0f, false, true, true), {SkillEffect::Evade, 0.5f, 0.0f}},
+        {"Substitute", SkillData(SkillType::Substitute, 15, 4, 0.0f, 0.0f, false, true, true), {SkillEffect::ReduceDamage, 1.0f, 0.25f}},
+
+        // Monster skills
+        {"Ember", SkillData(SkillType::Ember, 10, 2, 1.4f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Vine Whip", SkillData(SkillType::VineWhip, 8, 2, 1.3f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Tackle", SkillData(SkillType::Tackle, 5, 1, 1.0f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Dodge", SkillData(SkillType::Dodge, 5, 1, 0.0f, 0.0f, false, true, true), {SkillEffect::Evade, Constants::MONSTER_DODGE_CHANCE, 0.0f}},
+
+        // Legacy skills
+        {"Power Strike", SkillData(SkillType::PowerStrike, Constants::POWER_STRIKE_MP_COST, 1, Constants::POWER_STRIKE_MULTIPLIER, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Cleave", SkillData(SkillType::Cleave, 12, 2, 1.2f, 0.0f, true, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Heal", SkillData(SkillType::Heal, 10, 2, 0.0f, 0.8f, false, false, false), {SkillEffect::None, 0.0f, 0.0f}},
+        {"Guard", SkillData(SkillType::Guard, Constants::GUARD_MP_COST, 2, 0.0f, 0.0f, false, true, true), {SkillEffect::ReduceDamage, 1.0f, Constants::GUARD_DAMAGE_TAKEN}},
+        {"Counter", SkillData(SkillType::Counter, 10, 3, 0.0f, 0.0f, false, true, true), {SkillEffect::Counter, 1.0f, 0.3f}},
+        {"Fireball", SkillData(SkillType::Fireball, 12, 2, 1.4f, 0.0f, true, false, true), {SkillEffect::Debuff, 0.2f, 0.2f}},
+        {"Aqua Pulse", SkillData(SkillType::AquaPulse, 12, 2, 1.4f, 0.0f, true, false, true), {SkillEffect::Debuff, 0.2f, 0.2f}},
+        {"Leaf Blade", SkillData(SkillType::LeafBlade, 12, 2, 1.4f, 0.0f, true, false, true), {SkillEffect::Debuff, 0.2f, 0.2f}}
+    }};
+
+    constexpr const SkillInfo& get(SkillType type) {
+        return Table[static_cast<std::size_t>(type)];
+    }
+
+    constexpr int calculateDamage(SkillType type, int attackerATK) {
+        return static_cast<int>(attackerATK * get(type).data.damageMultiplier);
+    }
+
+    constexpr int calculateHealing(SkillType type, int attackerATK) {
+        return static_cast<int>(attackerATK * get(type).data.healMultiplier);
+    }
+
+    // Each row sits at its own SkillType and has an effect exactly when its
+    // data says so
+    constexpr bool tableIsConsistent() {
+        for (std::size_t i = 0; i < Count; ++i) {
+            const SkillInfo& info = Table[i];
+            if (static_cast<std::size_t>(info.data.type) != i) return false;
+            if (info.data.hasSpecialEffect != (info.effect.effect != SkillEffect::None)) return false;
+        }
+        return true;
+    }
+    static_assert(tableIsConsistent(), "Skills::Table rows must follow SkillType order");
+}
+
+// The skills one entity knows, in the order learned, with a cooldown per
+// SkillType. Fixed size: learning and using skills never allocates
+class SkillSet {
+public:
+    static constexpr std::size_t MaxSkills = 8;
 
-class Skill {
 public:
-    Skill(SkillType type, const std::string& name, const SkillData& data);
-    ~Skill();
-    
-    // Basic info
-    SkillType getType() const { return m_type; }
-    const std::string& getName() const { return m_name; }
-    const SkillData& getData() const { return m_data; }
-    
-    // Usage
-    bool canUse(int currentMP) const;
-    bool isOnCooldown() const { return m_currentCooldown > 0; }
-    int getCurrentCooldown() const { return m_currentCooldown; }
-    
-    // Cooldown management
-    void use();
-    void updateCooldown();
-    void resetCooldown();
-    
-    // Damage/healing calculation
-    int calculateDamage(int attackerATK) const;
-    int calculateHealing(int attackerATK) const;
-    
-    // Special effects
-    bool hasSpecialEffect() const { return m_data.hasSpecialEffect; }
-    void applySpecialEffect(class Entity& user, class Entity& target) const;
-    
-    // Factory methods for creating skills
-    // Legacy skills
-    static std::unique_ptr<Skill> createPowerStrike();
-    static std::unique_ptr<Skill> createCleave();
-    static std::unique_ptr<Skill> createHeal();
-    static std::unique_ptr<Skill> createGuard();
-    static std::unique_ptr<Skill> createCounter();
-    static std::unique_ptr<Skill> createFireball();
-    static std::unique_ptr<Skill> createAquaPulse();
-    static std::unique_ptr<Skill> createLeafBlade();
-
-    // Pikachu Attack Skills
-    static std::unique_ptr<Skill> createThunderBolt();
-    static std::unique_ptr<Skill> createQuickAttack();
-    static std::unique_ptr<Skill> createIronTail();
-
-    // Pikachu Defense Skills
-    static std::unique_ptr<Skill> createAgility();
-    static std::unique_ptr<Skill> createDoubleTeam();
-    static std::unique_ptr<Skill> createSubstitute();
-
-    // Monster Skills
-    static std::unique_ptr<Skill> createEmber();
-    static std::unique_ptr<Skill> createVineWhip();
-    static std::unique_ptr<Skill> createTackle();
-    static std::unique_ptr<Skill> createDodge();
-    
+    SkillSet();
+
+    // False when the skill is already known or the set is full
+    bool add(SkillType type);
+    void clear();
+
+    bool has(SkillType type) const { return (m_known >> static_cast<unsigned>(type)) & 1u; }
+    bool canUse(SkillType type, int currentMP) const;
+    int getCooldown(SkillType type) const { return m_cooldowns[static_cast<std::size_t>(type)]; }
+
+    // Starts the skill's cooldown
+    void use(SkillType type);
+    void updateCooldowns();
+    void resetCooldowns();
+
+    std::size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    const SkillType* begin() const { return m_order.data(); }
+    const SkillType* end() const { return m_order.data() + m_count; }
+
 private:
-    SkillType m_type;
-    std::string m_name;
-    SkillData m_data;
-    int m_currentCooldown;
+    std::array<SkillType, MaxSkills> m_order;
+    std::array<std::uint8_t, Skills::Count> m_cooldowns;
+    std::uint32_t m_known;      // Bit per SkillType
+    std::uint8_t m_count;
 };
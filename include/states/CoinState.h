@@ -1,5 +1,6 @@
 #pragma once
 #include "State.h"
+#include "core/AudioManager.h"
 #include "ui/TextLabel.h"
 #include "ui/Button.h"
 #include <functional>
@@ -11,7 +12,7 @@ public:
 public:
     CoinState(StateStack& stack, Context context);
     
-    virtual void draw() override;
+    virtual void draw(RenderList& target) override;
     virtual bool update(sf::Time dt) override;
     virtual bool handleEvent(const sf::Event& event) override;
     
@@ -43,6 +44,8 @@ private:
     CoinChoice m_playerChoice;
     bool m_coinResult; // true = heads, false = tails
     bool m_playerWon;
+
+    AudioManager::SoundHandle m_coinSound;
     
     ResultCallback m_resultCallback;
 };
@@ -1,98 +1,71 @@
 #pragma once
 #include "State.h"
-#include "entities/Player.h"
+#include "core/AudioManager.h"
+#include "core/CombatEngine.h"
+#include "core/CombatLog.h"
+#include "core/CombatSolver.h"
+#include "core/EventBus.h"
+#include "core/TaskScheduler.h"
 #include "entities/Enemy.h"
 #include "ui/TextLabel.h"
 #include "ui/Button.h"
-#include "ui/Bar.h"
 #include "ui/Panel.h"
 #include "ui/CombatUI.h"
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <memory>
 #include <cmath>
 
-enum class PikaAtkSkill {
-    Thunderbolt,
-    ElectroBall,
-    VoltTackle
-};
-
-enum class PikaDefSkill {
-    QuickGuard,
-    Agility,
-    Charge
-};
-
-struct StatusEffect {
-    enum Type { None, Stun, ATKBonus } type;
-    int duration;
-    int magnitude;
-
-    StatusEffect() : type(None), duration(0), magnitude(0) {}
-    StatusEffect(Type t, int dur, int mag = 0) : type(t), duration(dur), magnitude(mag) {}
-};
-
+// Presents a CombatEngine battle: turns input into engine actions, runs the
+// banner, coin flip and result timings around them, and plays each step's
+// events back as log entries, shakes and sounds
 class CombatState : public State {
 public:
     CombatState(StateStack& stack, Context context);
+    ~CombatState();
     
-    virtual void draw() override;
+    virtual void draw(RenderList& target) override;
     virtual bool update(sf::Time dt) override;
     virtual bool handleEvent(const sf::Event& event) override;
-    
-    // Setup
-    void initializeCombat(Player& player, bool isBoss = false);
-    void initializeCombat(Player& player, const std::string& enemyType);
+    virtual void onEnter() override;
+    virtual std::uint64_t stateHash() const override;
 
     // Result
     CombatResult getCombatResult() const { return m_combatResult; }
 
-    // Static result for communication with MapState
-    static CombatResult s_lastCombatResult;
-    static bool s_combatJustEnded;
-    
 private:
+    void onCombatStarted(const GameEvent& event);
     void setupUI();
-    void updateUI();
-    void addLogMessage(const std::string& message);
-    void drawCombatSprites(sf::RenderWindow& window, const class AssetManager& assets);
-    void performPlayerAttack();
-    void performEnemyAttack();
-    void checkCombatEnd();
-
-    // Enhanced combat flow
-    void beginPlayerTurn();
-    void resolvePlayerCoin(bool correct);
-    void beginEnemyTurn();
-    void resolveEnemyCoin(bool correct);
-
-    // Skill system
-    void applyPikaAtkSkill(PikaAtkSkill skill);
-    void applyPikaDefSkill(PikaDefSkill skill);
-    bool enemyTryDodge();
-    void updateStatusEffects();
+    void resetCombat();
+    // Adds a presenter line (battle start, hint) stamped with the current battle
+    void logEntry(CombatLogEntry entry);
+    // Formats the newest log lines into the labels; only called while shown
+    void refreshLogLabels();
+    void drawCombatSprites(RenderList& target, const class AssetManager& assets);
+
+    // Runs one engine step and presents it; returns false if it did not apply
+    bool applyAction(CombatEngine::Action action);
+    void presentEvent(const CombatEngine::Event& event);
+    // F1: logs the solver's best move and the win chance it leaves
+    void showHint();
+    // Lets the enemy declare its next move at each coin call
+    void planEnemyMove();
+
+    // Timed phases, run as coroutines on m_tasks. Each one re-checks the phase
+    // when it wakes, since input can leave the phase while it waits
+    void startPhaseTask(TaskScheduler::Task task);
+    void startCoinFlip(bool head);
+    void enterResultPhase(bool victory);
+    TaskScheduler::Task playReadyBanner();
+    TaskScheduler::Task flipCoin();
+    TaskScheduler::Task showResult();
 
     // Animation helpers
     void triggerAttackShake(bool isPlayer);
     void triggerHurtNudge(bool isPlayer);
-    
-    // Combat flow
-    void startPlayerTurn();
-    void startEnemyTurn();
-    void performCoinFlip();
-    void onCoinResult(bool playerWon);
-    void showSkillSelection();
-    void hideSkillSelection();
-    void useSkill(SkillType skillType);
-
-    void endCombat(CombatResult result);
-    
-    // UI callbacks
-    void onNormalAttackSelected();
-    void onSkillSelected(SkillType skillType);
-    
+
 private:
-    Player* m_player;
     std::unique_ptr<class Enemy> m_enemy;
     bool m_isBoss;
     
@@ -107,41 +80,35 @@ private:
         Ended
     } m_phase;
     
-    // UI elements
-    UI::Panel m_playerPanel;
-    UI::Panel m_enemyPanel;
+    // Combat log: events are stored as entries; text is only made for the
+    // last LogLines lines, and only while the log is shown (L)
+    static constexpr std::size_t LogLines = 5;
+    CombatLog m_log;
     UI::Panel m_logPanel;
-    UI::Panel m_skillPanel;
-    
-    UI::TextLabel m_playerNameLabel;
-    UI::TextLabel m_enemyNameLabel;
-    UI::Bar m_playerHPBar;
-    UI::Bar m_playerMPBar;
-    UI::Bar m_enemyHPBar;
-    UI::Bar m_enemyMPBar;
-    
-    std::vector<UI::TextLabel> m_logMessages;
-    UI::Button m_normalAttackButton;
-    std::vector<UI::Button> m_skillButtons;
+    std::array<UI::TextLabel, LogLines> m_logMessages;
+    std::size_t m_logLineCount;         // Labels in use, oldest on top
+    std::uint64_t m_logRendered;        // m_log.getTotal() the labels show
+    bool m_logVisible;
 
-    bool m_skillSelectionVisible;
-    bool m_waitingForInput;
+    // Encounter info from the CombatStarted event, echoed back on CombatEnded
+    EventBus::SubscriptionID m_combatStartedSub;
+    std::uint32_t m_session;
+    MonsterType m_monster;
+    Vec2i m_monsterPos;
 
     // Enhanced combat visuals
     std::string m_enemyType;  // "bisasam", "chalamander", "boss"
-    sf::Time m_bannerTimer;
     sf::Time m_bannerDuration;
 
-    // Coin flip mechanics
+    // The rules: fighters, statuses, coin outcome and open skill menu
+    CombatEngine m_engine;
+    // Keeps its table between hints; only the first one of a battle solves
+    CombatSolver m_solver;
+
+    // Coin call waiting for the flip to land
     enum class CoinChoice { None, Head, Tail } m_playerChoice;
-    enum class CoinResult { None, Head, Tail } m_coinResult;
-    sf::Time m_coinTimer;
     sf::Time m_coinDuration;
-    bool m_coinCorrect;
 
-    // Combat stats
-    int m_playerHP, m_playerMaxHP, m_playerATK, m_playerDEF;
-    int m_enemyHP, m_enemyMaxHP, m_enemyATK, m_enemyDEF;
     std::string m_playerName, m_enemyName;
 
     // UI buttons
@@ -149,10 +116,13 @@ private:
     UI::Button m_tailButton;
 
     // Result display
-    sf::Time m_resultTimer;
     sf::Time m_resultDuration;
     CombatResult m_combatResult;
 
+    // Phase timers run on the combat clock: paused whenever update() is not called
+    TaskScheduler m_tasks;
+    TaskScheduler::TaskID m_phaseTask;
+
     // Shake animation system
     struct Shake {
         bool active = false;
@@ -161,9 +131,10 @@ private:
         float amplitude = 10.0f;
         sf::Vector2f basePosition;
 
-        sf::Vector2f getOffset() const {
+        // ahead: seconds past the last update, for drawing between ticks
+        sf::Vector2f getOffset(float ahead = 0.0f) const {
             if (!active) return sf::Vector2f(0, 0);
-            float progress = t / duration;
+            float progress = std::min((t + ahead) / duration, 1.0f);
             float shakeX = std::sin(progress * 3.14159f * 4) * amplitude * (1.0f - progress);
             return sf::Vector2f(shakeX, 0);
         }
@@ -192,9 +163,10 @@ private:
         float distance = 6.0f;
         sf::Vector2f direction;
 
-        sf::Vector2f getOffset() const {
+        // ahead: seconds past the last update, for drawing between ticks
+        sf::Vector2f getOffset(float ahead = 0.0f) const {
             if (!active) return sf::Vector2f(0, 0);
-            float progress = t / duration;
+            float progress = std::min((t + ahead) / duration, 1.0f);
             float factor = 1.0f - progress; // Linear fade out
             return direction * distance * factor;
         }
@@ -218,13 +190,9 @@ private:
 
     Shake m_atkShakePika, m_atkShakeEnemy;
     Nudge m_hurtNudgePika, m_hurtNudgeEnemy;
-
-    // Status effects
-    StatusEffect m_playerStatus, m_enemyStatus;
+    AudioManager::SoundHandle m_hitSound;
 
     // Skill selection
-    bool m_showingSkillMenu;
-    bool m_isDefenseSkillMenu;
     std::vector<UI::Button> m_attackSkillButtons;
     std::vector<UI::Button> m_defenseSkillButtons;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "State.h"
+#include "core/AudioManager.h"
 #include "ui/TextLabel.h"
 #include <functional>
 
@@ -10,7 +11,7 @@ public:
 public:
     DiceState(StateStack& stack, Context context);
     
-    virtual void draw() override;
+    virtual void draw(RenderList& target) override;
     virtual bool update(sf::Time dt) override;
     virtual bool handleEvent(const sf::Event& event) override;
     
@@ -28,6 +29,8 @@ private:
     sf::Time m_totalAnimationTime;
     bool m_animating;
     int m_finalResult;
+
+    AudioManager::SoundHandle m_diceSound;
     
     ResultCallback m_resultCallback;
 };
@@ -14,7 +14,7 @@ class EnhancedCombatState : public State {
 public:
     EnhancedCombatState(StateStack& stack, Context context);
     
-    virtual void draw() override;
+    virtual void draw(RenderList& target) override;
     virtual bool update(sf::Time dt) override;
     virtual bool handleEvent(const sf::Event& event) override;
     
@@ -1,5 +1,8 @@
 #pragma once
 #include "State.h"
+#include "core/EventBus.h"
+#include "core/JobSystem.h"
+#include "core/TaskScheduler.h"
 #include "world/Map.h"
 #include "entities/Player.h"
 #include "ui/TextLabel.h"
@@ -10,10 +13,13 @@
 class MapState : public State {
 public:
     MapState(StateStack& stack, Context context);
+    ~MapState();
     
-    virtual void draw() override;
+    virtual void draw(RenderList& target) override;
     virtual bool update(sf::Time dt) override;
     virtual bool handleEvent(const sf::Event& event) override;
+    virtual bool isAnimating() const override;
+    virtual std::uint64_t stateHash() const override;
     
     // Game state management
     void initializeNewGame(PokemonType pokemonType);
@@ -30,13 +36,15 @@ public:
 
     // Auto-path system
     void startAutoPath(int steps);
-    void updateAutoPath(sf::Time dt);
+    TaskScheduler::Task walkPath();
+    void endTurn();
     std::optional<Vec2i> pickNextPosition();
     void checkCombatTrigger();
     void checkGoalReached();
 
     // Combat result handling
-    void onCombatEnded(CombatResult result);
+    void startCombat(MonsterType monster, const Vec2i& monsterPos);
+    void onCombatEnded(CombatResult result, const Vec2i& monsterPos);
     
     // Getters for other states
     Player& getPlayer() { return m_player; }
@@ -66,8 +74,18 @@ private:
     // Auto-path system
     int m_remainingSteps;
     bool m_autoPathActive;
-    sf::Time m_stepTimer;
     sf::Time m_stepDelay;
+
+    // Runs walkPath() on the map clock
+    TaskScheduler m_tasks;
+    TaskScheduler::TaskID m_walkTask;
     bool m_justTeleported;
-    Vec2i m_combatMonsterPos; // Store monster position for combat result handling
+
+    // Event bus subscriptions, filtered by this game's session
+    std::uint32_t m_session;
+    EventBus::SubscriptionID m_combatEndedSub;
+    EventBus::SubscriptionID m_saveRequestedSub;
+
+    // Last background save, so the next one queues behind it
+    JobSystem::JobHandle m_pendingSave;
 };
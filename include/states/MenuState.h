@@ -8,9 +8,10 @@ class MenuState : public State {
 public:
     MenuState(StateStack& stack, Context context);
     
-    virtual void draw() override;
+    virtual void draw(RenderList& target) override;
     virtual bool update(sf::Time dt) override;
     virtual bool handleEvent(const sf::Event& event) override;
+    virtual bool isAnimating() const override { return false; }
     
 private:
     void setupUI();
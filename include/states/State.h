@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <memory>
 #include "Types.h"
 
@@ -9,6 +10,9 @@ class AudioManager;
 class AssetManager;
 class RNG;
 class SaveSystem;
+class EventBus;
+class JobSystem;
+class RenderList;
 
 class State {
 public:
@@ -16,22 +20,46 @@ public:
     
     struct Context {
         Context(sf::RenderWindow& window, AudioManager& audio, AssetManager& assets, 
-                RNG& rng, SaveSystem& save);
+                RNG& rng, SaveSystem& save, EventBus& events, JobSystem& jobs);
         
         sf::RenderWindow* window;
         AudioManager* audio;
         AssetManager* assets;
         RNG* rng;
         SaveSystem* save;
+        EventBus* events;
+        JobSystem* jobs;
     };
     
 public:
     State(StateStack& stack, Context context);
     virtual ~State();
     
-    virtual void draw() = 0;
+    virtual void draw(RenderList& target) = 0;
     virtual bool update(sf::Time dt) = 0;
     virtual bool handleEvent(const sf::Event& event) = 0;
+
+    // Called when the state becomes part of the stack / leaves it.
+    // Pooled states are reused, so onEnter must reset any per-visit data.
+    virtual void onEnter() {}
+    virtual void onExit() {}
+
+    // Whether the state changes on its own between input events. When the top
+    // state is not animating the game sleeps until the next event and skips
+    // redrawing; states that cannot tell stay live
+    virtual bool isAnimating() const { return true; }
+
+    // Digest of the gameplay data replays must reproduce; 0 for pure UI states
+    virtual std::uint64_t stateHash() const { return 0; }
+
+    // FNV-1a step used to fold values into a state hash
+    static std::uint64_t hashCombine(std::uint64_t hash, std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
     
 protected:
     void requestStackPush(StateID stateID);
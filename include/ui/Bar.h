@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 
+class RenderList;
+
 namespace UI {
 
 class Bar {
@@ -33,9 +35,10 @@ public:
     void setAnimated(bool animated);
     void setAnimationSpeed(float speed);
     void update(sf::Time dt);
+    bool isAnimating() const;
     
     // Rendering
-    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+    void draw(RenderList& target, sf::RenderStates states = sf::RenderStates::Default) const;
     
     // Getters
     float getCurrentValue() const { return m_currentValue; }
@@ -3,6 +3,8 @@
 #include <functional>
 #include <string>
 
+class RenderList;
+
 namespace UI {
 
 class Button {
@@ -38,7 +40,7 @@ public:
     void update(sf::Time dt);
     
     // Rendering
-    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+    void draw(RenderList& target, sf::RenderStates states = sf::RenderStates::Default) const;
     
     // Utility
     bool contains(const sf::Vector2f& point) const;
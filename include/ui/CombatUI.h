@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 
+class RenderList;
+
 namespace CombatUI {
     // Stat panel data
     struct StatData {
@@ -18,26 +20,26 @@ namespace CombatUI {
     };
     
     // Panel drawing functions
-    void drawStatPanelTopLeft(sf::RenderTarget& target, const StatData& stats, const sf::Font& font, 
+    void drawStatPanelTopLeft(RenderList& target, const StatData& stats, const sf::Font& font, 
                              sf::Vector2f position = sf::Vector2f(40, 40), 
                              sf::Vector2f size = sf::Vector2f(360, 120));
                              
-    void drawStatPanelBottomRight(sf::RenderTarget& target, const StatData& stats, const sf::Font& font,
+    void drawStatPanelBottomRight(RenderList& target, const StatData& stats, const sf::Font& font,
                                  sf::Vector2f windowSize,
                                  sf::Vector2f size = sf::Vector2f(360, 120));
     
     // Banner drawing
-    void drawBanner(sf::RenderTarget& target, const std::string& text, const sf::Font& font,
+    void drawBanner(RenderList& target, const std::string& text, const sf::Font& font,
                    sf::Vector2f windowSize, sf::Color textColor = sf::Color::White);
 
     // HP Bar drawing
-    void drawHPBar(sf::RenderTarget& target, sf::Vector2f position, sf::Vector2f size,
+    void drawHPBar(RenderList& target, sf::Vector2f position, sf::Vector2f size,
                    int currentHP, int maxHP, sf::Color barColor = sf::Color::Red);
 
     // Coin flip UI
-    void drawCoinChoice(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f windowSize);
-    void drawCoinFlipping(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f windowSize);
-    void drawCoinResult(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f windowSize,
+    void drawCoinChoice(RenderList& target, const sf::Font& font, sf::Vector2f windowSize);
+    void drawCoinFlipping(RenderList& target, const sf::Font& font, sf::Vector2f windowSize);
+    void drawCoinResult(RenderList& target, const sf::Font& font, sf::Vector2f windowSize,
                        bool isHead, bool correct);
 
     // Helper functions
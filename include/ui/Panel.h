@@ -1,6 +1,8 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 
+class RenderList;
+
 namespace UI {
 
 class Panel {
@@ -18,7 +20,7 @@ public:
     void setOutlineThickness(float thickness);
     
     // Rendering
-    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+    void draw(RenderList& target, sf::RenderStates states = sf::RenderStates::Default) const;
     
     // Utility
     sf::FloatRect getBounds() const;
@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 
+class RenderList;
+
 namespace UI {
 
 class TextLabel {
@@ -32,7 +34,7 @@ public:
     void setOrigin(const sf::Vector2f& origin);
     
     // Rendering
-    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+    void draw(RenderList& target, sf::RenderStates states = sf::RenderStates::Default) const;
     
     // Utility
     sf::FloatRect getBounds() const;
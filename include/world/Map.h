@@ -1,12 +1,16 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
 #include <optional>
 #include "Tile.h"
 #include "Types.h"
+#include "core/LinearArena.h"
 
 class RNG;
+class RenderList;
 
 class Map {
 public:
@@ -64,10 +68,10 @@ public:
     std::vector<Vec2i>& getMonsterPositions() { return m_monsterPositions; }
 
     // Rendering
-    void draw(sf::RenderTarget& target, const sf::View& view) const;
-    void drawWithSprites(sf::RenderTarget& target, const sf::View& view, const class AssetManager& assets) const;
-    void drawVisitedTiles(sf::RenderTarget& target, const class Player& player) const;
-    void drawPlayer(sf::RenderTarget& target, const Vec2i& playerPos, const class AssetManager& assets) const;
+    void draw(RenderList& target, const sf::View& view) const;
+    void drawWithSprites(RenderList& target, const sf::View& view, const class AssetManager& assets) const;
+    void drawVisitedTiles(RenderList& target, const class Player& player) const;
+    void drawPlayer(RenderList& target, const Vec2i& playerPos, const class AssetManager& assets) const;
     
     // Getters
     int getWidth() const { return m_width; }
@@ -85,6 +89,7 @@ private:
     void placeMonsters(RNG& rng);
     void placeRocks(RNG& rng);
     void placeGameElements(RNG& rng, const std::vector<Vec2i>& pathCells);
+    std::pmr::vector<Vec2i> collectEmptyPositions();  // Candidate cells, allocated from m_scratch
     void distributeTiles(RNG& rng);  // Legacy method
     void ensurePathExists(RNG& rng);
 
@@ -93,6 +98,8 @@ private:
     char getTileChar(TileType type) const;
     TileType charToTileType(char c) const;
     bool isValidMazePosition(const Vec2i& pos) const;
+    void rebuildFloorLayer() const;
+    static void appendQuad(sf::VertexArray& vertices, const sf::FloatRect& rect, const sf::Color& color);
 
 private:
     int m_width;
@@ -107,6 +114,15 @@ private:
     std::vector<TeleportGate> m_teleportGates;
     std::vector<Vec2i> m_monsterPositions;
 
+    // Transient generation data (candidate lists, visited grids); reset at the
+    // start of each generate call, so nothing allocated from it outlives one
+    LinearArena m_scratch;
+
     // Rendering
     mutable sf::RectangleShape m_tileShape;
+
+    // Bumped on every tile write; the cached floor layer is rebuilt when it moves
+    unsigned int m_revision;
+    mutable unsigned int m_floorRevision;
+    mutable std::shared_ptr<const sf::Drawable> m_floorLayer;
 };
@@ -1,4 +1,5 @@
 #include "Game.h"
+#include "core/Profiler.h"
 #include "states/MenuState.h"
 #include "states/MapState.h"
 #include "states/DiceState.h"
@@ -7,22 +8,118 @@
 #include "states/GameOverState.h"
 #include "states/VictoryState.h"
 #include "states/PauseState.h"
+#include "core/Autopilot.h"
+#include "core/AllocationCounter.h"
+#include "core/LinearArena.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <ctime>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#endif
+
+namespace {
+    // CPU time of the whole process (every thread, including audio and workers)
+    double processCpuSeconds() {
+#ifdef _WIN32
+        FILETIME creation, exitTime, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0.0;
+        auto toSeconds = [](const FILETIME& time) {
+            return ((static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1e-7;
+        };
+        return toSeconds(kernel) + toSeconds(user);
+#else
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    const char* stateName(StateID id) {
+        switch (id) {
+            case StateID::Menu: return "Menu";
+            case StateID::Map: return "Map";
+            case StateID::Dice: return "Dice";
+            case StateID::Coin: return "Coin";
+            case StateID::Combat: return "Combat";
+            case StateID::EnhancedCombat: return "EnhancedCombat";
+            case StateID::Ready: return "Ready";
+            case StateID::GameOver: return "GameOver";
+            case StateID::Victory: return "Victory";
+            case StateID::Pause: return "Pause";
+        }
+        return "?";
+    }
+}
 
 const sf::Time Game::TimePerFrame = sf::seconds(1.f / Constants::TARGET_FPS);
 Game* g_game = nullptr;
 
-Game::Game()
-    : m_window(sf::VideoMode(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT), "Mini Game SFML")
-    , m_stateStack(State::Context(m_window, m_audioManager, m_assetManager, m_rng, m_saveSystem))
+Game::Game(const GameOptions& options)
+    : m_options(options)
+    , m_window()
+    , m_stateStack(State::Context(m_window, m_audioManager, m_assetManager, m_rng, m_saveSystem, m_eventBus, m_jobSystem))
+    , m_tick(0)
+    , m_inputDispatched(0)
+    , m_inputDisplayed(0)
+    , m_latencySamples(0)
+    , m_droppedFrames(0)
+    , m_interpolationAlpha(0.f)
+    , m_hasFocus(true)
+    , m_idleWaits(0)
+    , m_allocationMark(0)
+    , m_allocationFrames(0)
+    , m_allocationTotal(0)
+    , m_allocationMax(0)
+    , m_allocationLast(0)
+    , m_renderSize(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT)
     , m_statisticsUpdateTime()
     , m_statisticsNumFrames(0)
     , m_isPaused(false)
+    , m_exitCode(0)
 {
     g_game = this;
-    
+
+    if (m_options.hasSeed) {
+        m_rng.setSeed(m_options.seed);
+    }
+
+    const bool replaying = !m_options.replayFile.empty();
+    if (replaying) {
+        if (!m_replay.open(m_options.replayFile)) {
+            m_exitCode = 1;
+            return;
+        }
+        // Every roll in the session derives from this seed
+        m_rng.setSeed(m_replay.getSeed());
+    }
+
+    if (m_options.headless) {
+        // No window, rendering or audio: states only run their logic
+        m_audioManager.setEnabled(false);
+        registerStates();
+        m_stateStack.prewarmState(StateID::Combat);
+
+        if (replaying) {
+            // Recordings start at the menu, and button hit tests need the real font metrics
+            m_assetManager.loadAll(m_jobSystem);
+            m_stateStack.pushState(StateID::Menu);
+        } else {
+            m_stateStack.pushState(StateID::Map);
+        }
+        return;
+    }
+
+    m_window.create(sf::VideoMode(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT), "Mini Game SFML");
     m_window.setKeyRepeatEnabled(false);
-    m_window.setVerticalSyncEnabled(true);
+    m_window.setVerticalSyncEnabled(!replaying);
     
     // Initialize statistics text
     m_statisticsText.setFont(m_assetManager.getDefaultFont());
@@ -31,64 +128,497 @@ Game::Game()
     m_statisticsText.setFillColor(sf::Color::White);
     
     // Load all game assets
-    m_assetManager.loadAll();
+    m_assetManager.loadAll(m_jobSystem);
+
+    // Decode every sound effect up front so the first play never stalls
+    m_audioManager.setSoundCacheCapacity(Constants::SFX_DECODE_CACHE_SIZE);
+    m_audioManager.loadSoundBank(
+        std::vector<std::string>(std::begin(Constants::SFX_MANIFEST), std::end(Constants::SFX_MANIFEST)), m_jobSystem,
+        Constants::SFX_KEEP_COMPRESSED ? SoundBank::Storage::Compressed : SoundBank::Storage::Decoded);
+
+    // Start reading the menu track before the first state asks for it
+    m_audioManager.prefetchMusic(Constants::BGM_MENU);
+
+#ifdef DEBUG
+    // Telemetry hook: trace every event delivered on the bus
+    m_eventBus.subscribeAll([](const GameEvent& event) {
+        std::cout << "Event " << static_cast<int>(event.type) << " (session " << event.session << ")" << std::endl;
+    });
+#endif
 
     registerStates();
+
+    // Build the combat screen once so encounters only reset its data
+    m_stateStack.prewarmState(StateID::Combat);
     m_stateStack.pushState(StateID::Menu);
+
+    if (!m_options.recordFile.empty()) {
+        m_recorder.open(m_options.recordFile, m_rng.getSeed());
+    }
 }
 
 Game::~Game() {
+    m_recorder.close(m_tick);
+
+#ifdef ENABLE_PROFILER
+    Profiler::instance().exportChromeTrace(Constants::PROFILE_TRACE_PATH);
+#endif
     g_game = nullptr;
 }
 
 void Game::run() {
-    sf::Clock clock;
+    if (!m_options.replayFile.empty()) {
+        if (m_replay.isOpen()) {
+            runReplay();
+        }
+        return;
+    }
+
+    if (m_options.headless) {
+        runHeadless();
+        return;
+    }
+
+    if (m_options.threaded) {
+        runThreaded();
+        return;
+    }
+
+    const float timeScale = m_options.timeScale;
+    const bool unbounded = timeScale <= 0.f;
+
+    // Faster clocks legitimately need more steps per frame; the cap only trims hitches
+    const std::size_t maxSteps = unbounded ? std::numeric_limits<std::size_t>::max()
+        : static_cast<std::size_t>(std::ceil(Constants::MAX_CATCHUP_STEPS * std::max(timeScale, 1.f)));
+
+    sf::Time lastFrame = m_inputClock.getElapsedTime();
     sf::Time timeSinceLastUpdate = sf::Time::Zero;
+    double lastCpu = processCpuSeconds();
     
     while (m_window.isOpen()) {
-        sf::Time deltaTime = clock.restart();
-        timeSinceLastUpdate += deltaTime;
-        
-        while (timeSinceLastUpdate > TimePerFrame) {
-            timeSinceLastUpdate -= TimePerFrame;
-            
-            processInput();
-            update(TimePerFrame);
-            
-            if (m_stateStack.isEmpty()) {
-                m_window.close();
+        beginFrame();
+        sf::Time frameStart = m_inputClock.getElapsedTime();
+        bool hasState = !m_stateStack.isEmpty();
+        StateID frameState = hasState ? m_stateStack.getTopStateID() : StateID::Menu;
+
+        if (isIdle()) {
+            // Nothing on screen can change before the next event: block instead
+            // of stepping and redrawing an identical frame
+            sf::Event event;
+            if (m_window.waitEvent(event)) {
+                queueEvent(event, m_inputClock.getElapsedTime());
             }
+            ++m_idleWaits;
+
+            // The wait is not simulation backlog; the woken frame runs one step
+            lastFrame = m_inputClock.getElapsedTime();
+            timeSinceLastUpdate = TimePerFrame;
+        }
+
+        sf::Time now = m_inputClock.getElapsedTime();
+        sf::Time deltaTime = now - lastFrame;
+        lastFrame = now;
+
+        // Sample once per frame, not once per step: after a long frame the
+        // catch-up steps would otherwise all run on input from the first one
+        processInput();
+
+        if (unbounded) {
+            // Spend one frame's worth of wall time on steps, then present
+            sf::Time deadline = now + TimePerFrame;
+            deliverInput(now);
+            do {
+                update(TimePerFrame);
+            } while (!m_stateStack.isEmpty() && m_inputClock.getElapsedTime() < deadline);
+        } else {
+            timeSinceLastUpdate += deltaTime * timeScale;
+
+            // Wall-clock time the simulation has caught up to
+            const sf::Time wallPerStep = TimePerFrame / timeScale;
+            sf::Time simulatedUpTo = now - timeSinceLastUpdate / timeScale;
+            std::size_t steps = 0;
+
+            while (timeSinceLastUpdate >= TimePerFrame && steps < maxSteps && !m_stateStack.isEmpty()) {
+                timeSinceLastUpdate -= TimePerFrame;
+                simulatedUpTo += wallPerStep;
+                ++steps;
+
+                // Earlier steps only take input that arrived during their slot. The
+                // last one also takes this frame's input instead of holding it a frame
+                bool lastStep = timeSinceLastUpdate < TimePerFrame || steps == maxSteps;
+                deliverInput(lastStep ? now : simulatedUpTo);
+                update(TimePerFrame);
+            }
+
+            if (timeSinceLastUpdate >= TimePerFrame) {
+                // Catching up on a hitch (synchronous load, save) would only make
+                // the next frame longer; drop the backlog, keep the partial step
+                sf::Time kept = sf::microseconds(timeSinceLastUpdate.asMicroseconds() % TimePerFrame.asMicroseconds());
+                m_droppedTime += timeSinceLastUpdate - kept;
+                ++m_droppedFrames;
+                timeSinceLastUpdate = kept;
+            }
+        }
+
+        if (m_stateStack.isEmpty()) {
+            m_window.close();
         }
         
+        m_interpolationAlpha = timeSinceLastUpdate / TimePerFrame;
         updateStatistics(deltaTime);
         render();
+
+        if (!m_hasFocus) {
+            // Nobody is looking: cap the frame rate instead of running at vsync
+            sf::Time budget = sf::seconds(1.f / Constants::UNFOCUSED_FPS);
+            sf::Time frameTime = m_inputClock.getElapsedTime() - frameStart;
+            if (frameTime < budget) {
+                sf::sleep(budget - frameTime);
+            }
+        }
+
+        double cpu = processCpuSeconds();
+        if (hasState) {
+            trackStateCpu(frameState, cpu - lastCpu, m_inputClock.getElapsedTime() - frameStart);
+        }
+        lastCpu = cpu;
+    }
+
+    reportTelemetry();
+}
+
+void Game::runHeadless() {
+    Autopilot autopilot(m_eventBus, m_rng.getSeed());
+
+    // Per-step logging would dominate the run time; silence it until the report
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+
+    sf::Clock wallClock;
+    sf::Time simulated = sf::Time::Zero;
+    sf::Time sinceLastTurn = sf::Time::Zero;
+    std::size_t lastTurns = 0;
+    bool stalled = false;
+
+    // Virtual clock: every iteration advances exactly one fixed step, without waiting
+    while (autopilot.getStats().turns < m_options.headlessTurns) {
+        beginFrame();
+
+        // The first push is still pending until the first update
+        if (!m_stateStack.isEmpty()) {
+            StateID top = m_stateStack.getTopStateID();
+            if (top == StateID::Victory || top == StateID::GameOver) {
+                autopilot.onGameFinished();
+                m_stateStack.clearStates();
+                m_stateStack.pushState(StateID::Map);
+            } else {
+                sf::Event event;
+                if (autopilot.nextEvent(top, event)) {
+                    m_stateStack.handleEvent(event);
+                }
+            }
+        }
+
+        update(TimePerFrame);
+        simulated += TimePerFrame;
+
+        if (m_stateStack.isEmpty()) break;
+
+        if (autopilot.getStats().turns != lastTurns) {
+            lastTurns = autopilot.getStats().turns;
+            sinceLastTurn = sf::Time::Zero;
+        } else if ((sinceLastTurn += TimePerFrame) > sf::seconds(Constants::HEADLESS_STALL_SECONDS)) {
+            stalled = true;
+            break;
+        }
     }
+
+    sf::Time wall = wallClock.getElapsedTime();
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    const Autopilot::Stats& stats = autopilot.getStats();
+    float wallSeconds = std::max(wall.asSeconds(), 0.000001f);
+    std::cout << "Headless run (seed " << m_rng.getSeed() << ")" << (stalled ? " stopped: no turn progress" : "") << "\n"
+              << "  Turns:     " << stats.turns << "\n"
+              << "  Combats:   " << stats.combats << " (" << stats.victories << " won, " << stats.defeats << " lost)\n"
+              << "  Games:     " << stats.games << "\n"
+              << "  Simulated: " << simulated.asSeconds() << " s\n"
+              << "  Wall:      " << wall.asSeconds() << " s (" << simulated.asSeconds() / wallSeconds << "x real time)\n"
+              << "  Rate:      " << stats.turns / wallSeconds << " turns/s\n"
+              << "  Heap:      " << (m_allocationFrames > 0 ? static_cast<double>(m_allocationTotal) / m_allocationFrames : 0.0)
+              << " allocations/tick avg, " << m_allocationMax << " max" << std::endl;
+}
+
+void Game::runReplay() {
+    // Same silencing as the headless run so logging does not skew the speed figure
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+
+    sf::Clock wallClock;
+    std::size_t checkpoints = 0;
+    std::size_t mismatches = 0;
+    std::uint64_t firstMismatch = 0;
+
+    // Feed each tick exactly the events it saw when recorded, without waiting
+    while (!m_replay.isFinished(m_tick)) {
+        beginFrame();
+        std::uint64_t tick = m_tick;
+        sf::Event event;
+        while (m_replay.pollEvent(tick, event)) {
+            m_stateStack.handleEvent(event);
+        }
+
+        update(TimePerFrame);
+
+        std::uint64_t expected = 0;
+        if (m_replay.checkpointAt(tick, expected)) {
+            ++checkpoints;
+            if (m_stateStack.stateHash() != expected && mismatches++ == 0) {
+                firstMismatch = tick;
+            }
+        }
+
+        if (!m_options.headless) {
+            // Live input is ignored; only closing the window stops the replay
+            while (m_window.pollEvent(event)) {
+                if (event.type == sf::Event::Closed) {
+                    m_window.close();
+                }
+            }
+            if (!m_window.isOpen()) break;
+            render();
+        }
+
+        if (m_stateStack.isEmpty()) break;
+    }
+
+    sf::Time wall = wallClock.getElapsedTime();
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    float simulated = m_tick * TimePerFrame.asSeconds();
+    float wallSeconds = std::max(wall.asSeconds(), 0.000001f);
+    std::cout << "Replay of " << m_options.replayFile << " (seed " << m_replay.getSeed() << ")\n"
+              << "  Ticks:       " << m_tick << " / " << m_replay.getFinalTick() << "\n"
+              << "  Events:      " << m_replay.getEventCount() << "\n"
+              << "  Simulated:   " << simulated << " s\n"
+              << "  Wall:        " << wall.asSeconds() << " s (" << simulated / wallSeconds << "x real time)\n"
+              << "  Checkpoints: " << checkpoints - mismatches << " / " << checkpoints << " matched";
+    if (mismatches > 0) {
+        std::cout << ", first divergence at tick " << firstMismatch;
+    }
+    std::cout << std::endl;
+
+    m_exitCode = mismatches > 0 ? 2 : 0;
+}
+
+void Game::runThreaded() {
+    // From here on text is laid out on the simulation thread; fill the glyph
+    // pages now so that never has to rasterize while the render thread draws
+    m_assetManager.prewarmGlyphs();
+    m_renderSize = m_window.getSize();
+
+    std::atomic<bool> running(true);
+    std::thread simulation(&Game::simulationLoop, this, std::ref(running));
+
+    // Render thread: owns the window and never touches a state
+    sf::Clock clock;
+    while (running.load(std::memory_order_acquire)) {
+        beginFrame();
+        sf::Event event;
+        while (m_window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                running.store(false, std::memory_order_release);
+            }
+            if (isLatencyProbe(event)) {
+                m_inputInFlight.push_back(m_inputClock.getElapsedTime());
+            }
+            std::lock_guard<std::mutex> lock(m_inputMutex);
+            m_pendingInput.push_back(event);
+        }
+
+        // Keeps the previous snapshot when no tick finished since the last frame
+        m_snapshots.consume();
+        updateStatistics(clock.restart());
+
+        PROFILE_SCOPE("Game::render");
+        const RenderSnapshot& snapshot = m_snapshots.readBuffer();
+        m_window.clear();
+        snapshot.drawList.replay(m_window);
+#ifdef DEBUG
+        m_window.draw(m_statisticsText);
+#endif
+        m_window.display();
+        trackDisplayedInput(snapshot.inputDispatched);
+    }
+
+    simulation.join();
+    m_window.close();
+    reportTelemetry();
+}
+
+void Game::simulationLoop(std::atomic<bool>& running) {
+    using Clock = std::chrono::steady_clock;
+    const float timeScale = m_options.timeScale;
+    const bool unbounded = timeScale <= 0.f;
+    const Clock::duration step = std::chrono::microseconds(
+        unbounded ? 0 : static_cast<std::int64_t>(TimePerFrame.asMicroseconds() / timeScale));
+
+    Clock::time_point next = Clock::now();
+    std::vector<sf::Event> events;
+    double totalLatenessMs = 0.0;
+    double maxLatenessMs = 0.0;
+    std::uint64_t ticks = 0;
+    std::size_t resyncs = 0;
+    Clock::duration dropped = Clock::duration::zero();
+
+    while (running.load(std::memory_order_acquire)) {
+        // Jitter: how late this tick started against its slot on the fixed grid
+        double latenessMs = std::chrono::duration<double, std::milli>(Clock::now() - next).count();
+        totalLatenessMs += std::max(latenessMs, 0.0);
+        maxLatenessMs = std::max(maxLatenessMs, latenessMs);
+        ++ticks;
+
+        // This thread's frame arena lives per tick; allocation counts stay with the render thread
+        LinearArena::frame().reset();
+
+        {
+            std::lock_guard<std::mutex> lock(m_inputMutex);
+            events.swap(m_pendingInput);
+        }
+        for (const sf::Event& event : events) {
+            dispatchEvent(event);
+        }
+        events.clear();
+
+        update(TimePerFrame);
+        if (m_stateStack.isEmpty()) {
+            running.store(false, std::memory_order_release);
+            break;
+        }
+
+        {
+            PROFILE_SCOPE("Game::recordSnapshot");
+            RenderSnapshot& snapshot = m_snapshots.writeBuffer();
+            snapshot.tick = m_tick;
+            snapshot.inputDispatched = m_inputDispatched;
+            snapshot.drawList.reset(m_renderSize);
+            m_stateStack.draw(snapshot.drawList);
+            m_snapshots.publish();
+        }
+
+        if (unbounded) {
+            next = Clock::now();
+            continue;
+        }
+
+        next += step;
+        Clock::time_point now = Clock::now();
+        if (now < next) {
+            std::this_thread::sleep_until(next);
+        } else if (now - next > step * Constants::MAX_CATCHUP_STEPS) {
+            // Stalled (hitch, debugger): resume on a fresh grid instead of
+            // bursting through the missed ticks
+            dropped += now - next;
+            ++resyncs;
+            next = now;
+        }
+    }
+
+    std::cout << "Simulation thread: " << ticks << " ticks, start jitter avg "
+              << (ticks > 0 ? totalLatenessMs / ticks : 0.0) << " ms, max " << maxLatenessMs << " ms, "
+              << resyncs << " resyncs dropped " << std::chrono::duration<double, std::milli>(dropped).count()
+              << " ms" << std::endl;
 }
 
 void Game::processInput() {
+    PROFILE_SCOPE("Game::processInput");
+    sf::Time now = m_inputClock.getElapsedTime();
     sf::Event event;
     while (m_window.pollEvent(event)) {
-        m_stateStack.handleEvent(event);
-        
-        if (event.type == sf::Event::Closed) {
-            m_window.close();
-        }
+        queueEvent(event, now);
+    }
+}
+
+void Game::queueEvent(const sf::Event& event, sf::Time timestamp) {
+    m_inputQueue.push_back(TimedEvent{event, timestamp});
+    if (isLatencyProbe(event)) {
+        m_inputInFlight.push_back(timestamp);
     }
+
+    if (event.type == sf::Event::LostFocus) {
+        m_hasFocus = false;
+    } else if (event.type == sf::Event::GainedFocus) {
+        m_hasFocus = true;
+    } else if (event.type == sf::Event::Closed) {
+        m_window.close();
+    }
+}
+
+bool Game::isIdle() const {
+    // Idle only when neither input, the bus, audio nor the top state has work
+    // left that a later step would pick up
+    return m_options.idleWait
+        && !m_stateStack.isEmpty()
+        && m_inputQueue.empty()
+        && m_eventBus.getPendingCount() == 0
+        && m_audioManager.isIdle()
+        && !m_stateStack.isAnimating();
+}
+
+void Game::deliverInput(sf::Time upTo) {
+    while (!m_inputQueue.empty() && m_inputQueue.front().timestamp <= upTo) {
+        dispatchEvent(m_inputQueue.front().event);
+        m_inputQueue.pop_front();
+    }
+}
+
+void Game::dispatchEvent(const sf::Event& event) {
+    if (isLatencyProbe(event)) {
+        ++m_inputDispatched;
+    }
+    m_recorder.recordEvent(m_tick, event);
+    m_stateStack.handleEvent(event);
+
+    if (event.type == sf::Event::Resized) {
+        m_renderSize = sf::Vector2u(event.size.width, event.size.height);
+    }
+
+#ifdef ENABLE_PROFILER
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9) {
+        Profiler::instance().exportChromeTrace(Constants::PROFILE_TRACE_PATH);
+    }
+#endif
 }
 
 void Game::update(sf::Time deltaTime) {
+    PROFILE_SCOPE("Game::update");
+    m_jobSystem.pumpMainThread();
     m_stateStack.update(deltaTime);
+    m_eventBus.dispatch();
+    m_audioManager.update(deltaTime);
+
+    if (m_recorder.isOpen() && (m_tick + 1) % Constants::REPLAY_CHECKPOINT_TICKS == 0) {
+        m_recorder.recordCheckpoint(m_tick, m_stateStack.stateHash());
+    }
+    ++m_tick;
 }
 
 void Game::render() {
+    PROFILE_SCOPE("Game::render");
     m_window.clear();
-    m_stateStack.draw();
+    RenderList target(m_window);
+    target.setInterpolation(m_interpolationAlpha);
+    m_stateStack.draw(target);
     
 #ifdef DEBUG
     m_window.draw(m_statisticsText);
 #endif
     
-    m_window.display();
+    {
+        PROFILE_SCOPE("Window::display");
+        m_window.display();
+    }
+    trackDisplayedInput(m_inputDispatched);
 }
 
 void Game::registerStates() {
@@ -96,18 +626,106 @@ void Game::registerStates() {
     m_stateStack.registerState<MapState>(StateID::Map);
     m_stateStack.registerState<DiceState>(StateID::Dice);
     m_stateStack.registerState<CoinState>(StateID::Coin);
-    m_stateStack.registerState<CombatState>(StateID::Combat);
+    m_stateStack.registerPooledState<CombatState>(StateID::Combat);
     m_stateStack.registerState<GameOverState>(StateID::GameOver);
     m_stateStack.registerState<VictoryState>(StateID::Victory);
     m_stateStack.registerState<PauseState>(StateID::Pause);
 }
 
+bool Game::isLatencyProbe(const sf::Event& event) {
+    return event.type == sf::Event::KeyPressed || event.type == sf::Event::MouseButtonPressed;
+}
+
+void Game::trackDisplayedInput(std::uint64_t dispatched) {
+    // Every press the presented frame has seen is now on screen
+    sf::Time now = m_inputClock.getElapsedTime();
+    while (m_inputDisplayed < dispatched && !m_inputInFlight.empty()) {
+        sf::Time latency = now - m_inputInFlight.front();
+        m_inputInFlight.pop_front();
+        ++m_inputDisplayed;
+
+        ++m_latencySamples;
+        m_latencyTotal += latency;
+        m_latencyMax = std::max(m_latencyMax, latency);
+    }
+}
+
+void Game::beginFrame() {
+    // Whatever the previous frame put in the arena is dead by now
+    LinearArena::frame().reset();
+
+    // Startup (asset loading, state construction) is not a frame
+    std::uint64_t allocations = AllocationCounter::count();
+    std::uint64_t mark = std::exchange(m_allocationMark, allocations);
+    if (mark == 0) return;
+
+    m_allocationLast = allocations - mark;
+    ++m_allocationFrames;
+    m_allocationTotal += m_allocationLast;
+    m_allocationMax = std::max(m_allocationMax, m_allocationLast);
+}
+
+void Game::trackStateCpu(StateID state, double cpuSeconds, sf::Time wall) {
+    StateCpu& entry = m_stateCpu[static_cast<std::size_t>(state)];
+    entry.cpuSeconds += cpuSeconds;
+    entry.wallSeconds += wall.asSeconds();
+}
+
+void Game::reportTelemetry() const {
+    if (m_latencySamples > 0) {
+        std::cout << "Input-to-display latency: " << m_latencySamples << " presses, avg "
+                  << m_latencyTotal.asMicroseconds() / 1000.0 / m_latencySamples << " ms, max "
+                  << m_latencyMax.asMicroseconds() / 1000.0 << " ms" << std::endl;
+    }
+    if (m_idleWaits > 0) {
+        std::cout << "Idle waits: " << m_idleWaits << std::endl;
+    }
+
+    // 100% is one core busy the whole time the state was on top
+    bool header = false;
+    for (std::size_t i = 0; i < StateCount; ++i) {
+        const StateCpu& entry = m_stateCpu[i];
+        if (entry.wallSeconds <= 0.0) continue;
+
+        if (!header) {
+            std::cout << "CPU by top state" << (m_options.idleWait ? "" : " (--no-idle)") << ":" << std::endl;
+            header = true;
+        }
+        std::cout << "  " << stateName(static_cast<StateID>(i)) << ": "
+                  << 100.0 * entry.cpuSeconds / entry.wallSeconds << "% over " << entry.wallSeconds << " s" << std::endl;
+    }
+
+    if (m_allocationFrames > 0) {
+        const LinearArena& arena = LinearArena::frame();
+        std::cout << "Heap allocations: " << static_cast<double>(m_allocationTotal) / m_allocationFrames
+                  << " per frame avg, " << m_allocationMax << " max; frame arena peak "
+                  << arena.getHighWater() << " bytes, " << arena.getOverflowCount() << " overflows" << std::endl;
+    }
+
+    if (m_droppedFrames > 0) {
+        std::cout << "Catch-up cap: hit on " << m_droppedFrames << " frames, dropped "
+                  << m_droppedTime.asSeconds() << " s of simulation" << std::endl;
+    }
+}
+
 void Game::updateStatistics(sf::Time deltaTime) {
     m_statisticsUpdateTime += deltaTime;
     m_statisticsNumFrames += 1;
     
     if (m_statisticsUpdateTime >= sf::seconds(1.0f)) {
-        m_statisticsText.setString("FPS: " + std::to_string(m_statisticsNumFrames));
+        std::string statistics = "FPS: " + std::to_string(m_statisticsNumFrames);
+        if (m_latencySamples > 0) {
+            statistics += "\nInput latency: "
+                + std::to_string(m_latencyTotal.asMilliseconds() / static_cast<sf::Int32>(m_latencySamples)) + " ms avg, "
+                + std::to_string(m_latencyMax.asMilliseconds()) + " ms max";
+        }
+        statistics += "\nHeap allocations: " + std::to_string(m_allocationLast) + " last frame, "
+            + std::to_string(m_allocationMax) + " max";
+        if (m_droppedFrames > 0) {
+            statistics += "\nDropped: " + std::to_string(m_droppedTime.asMilliseconds()) + " ms in "
+                + std::to_string(m_droppedFrames) + " hitches";
+        }
+        m_statisticsText.setString(statistics);
         
         m_statisticsUpdateTime -= sf::seconds(1.0f);
         m_statisticsNumFrames = 0;
@@ -1,34 +1,51 @@
 #include "StateStack.h"
+#include "core/Profiler.h"
 #include <cassert>
+#include <iostream>
 
 StateStack::StateStack(State::Context context)
     : m_stack()
     , m_pendingList()
     , m_context(context)
     , m_factories()
+    , m_measuringPush(false)
+    , m_pushWasWarm(false)
+    , m_lastPushLatency(sf::Time::Zero)
 {
 }
 
 void StateStack::update(sf::Time dt) {
+    PROFILE_SCOPE("StateStack::update");
     // Iterate from top to bottom, stop as soon as update() returns false
     for (auto itr = m_stack.rbegin(); itr != m_stack.rend(); ++itr) {
-        if (!(*itr)->update(dt))
+        if (!itr->state->update(dt))
             break;
     }
     
     applyPendingChanges();
 }
 
-void StateStack::draw() {
+void StateStack::draw(RenderList& target) {
+    PROFILE_SCOPE("StateStack::draw");
     // Draw all active states from bottom to top
-    for (State::Ptr& state : m_stack)
-        state->draw();
+    for (ActiveState& active : m_stack)
+        active.state->draw(target);
+
+    if (m_measuringPush) {
+        m_lastPushLatency = m_pushClock.getElapsedTime();
+        m_measuringPush = false;
+#ifdef DEBUG
+        std::cout << "State push-to-first-frame: " << m_lastPushLatency.asMicroseconds() / 1000.0f
+                  << " ms (" << (m_pushWasWarm ? "pooled" : "created") << ")" << std::endl;
+#endif
+    }
 }
 
 void StateStack::handleEvent(const sf::Event& event) {
+    PROFILE_SCOPE("StateStack::handleEvent");
     // Iterate from top to bottom, stop as soon as handleEvent() returns false
     for (auto itr = m_stack.rbegin(); itr != m_stack.rend(); ++itr) {
-        if (!(*itr)->handleEvent(event))
+        if (!itr->state->handleEvent(event))
             break;
     }
     
@@ -37,6 +54,7 @@ void StateStack::handleEvent(const sf::Event& event) {
 
 void StateStack::pushState(StateID stateID) {
     m_pendingList.push_back(PendingChange{Push, stateID});
+    m_pushClock.restart();
 }
 
 void StateStack::popState() {
@@ -51,6 +69,32 @@ bool StateStack::isEmpty() const {
     return m_stack.empty();
 }
 
+bool StateStack::isAnimating() const {
+    // Every state stops updates from reaching the ones below it, so only the
+    // top state can change without input
+    return !m_pendingList.empty() || m_measuringPush || (!m_stack.empty() && m_stack.back().state->isAnimating());
+}
+
+StateID StateStack::getTopStateID() const {
+    assert(!m_stack.empty());
+    return m_stack.back().stateID;
+}
+
+std::uint64_t StateStack::stateHash() const {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const ActiveState& active : m_stack) {
+        hash = State::hashCombine(hash, static_cast<std::uint64_t>(active.stateID));
+        hash = State::hashCombine(hash, active.state->stateHash());
+    }
+    return hash;
+}
+
+void StateStack::prewarmState(StateID stateID) {
+    if (m_pooledIDs.count(stateID) && !m_pool[stateID]) {
+        m_pool[stateID] = createState(stateID);
+    }
+}
+
 State::Ptr StateStack::createState(StateID stateID) {
     auto found = m_factories.find(stateID);
     assert(found != m_factories.end());
@@ -58,20 +102,46 @@ State::Ptr StateStack::createState(StateID stateID) {
     return found->second();
 }
 
+void StateStack::removeTopState() {
+    ActiveState& top = m_stack.back();
+    top.state->onExit();
+
+    if (m_pooledIDs.count(top.stateID)) {
+        m_pool[top.stateID] = std::move(top.state);
+    }
+
+    m_stack.pop_back();
+}
+
 void StateStack::applyPendingChanges() {
+    PROFILE_SCOPE("StateStack::applyPendingChanges");
     for (PendingChange change : m_pendingList) {
         switch (change.action) {
-            case Push:
-                m_stack.push_back(createState(change.stateID));
+            case Push: {
+                // Reuse an idle pooled instance when one is available
+                State::Ptr state;
+                auto pooled = m_pool.find(change.stateID);
+                m_pushWasWarm = pooled != m_pool.end() && pooled->second;
+                if (m_pushWasWarm) {
+                    state = std::move(pooled->second);
+                } else {
+                    state = createState(change.stateID);
+                }
+
+                state->onEnter();
+                m_stack.push_back(ActiveState{change.stateID, std::move(state)});
+                m_measuringPush = true;
                 break;
+            }
                 
             case Pop:
                 if (!m_stack.empty())
-                    m_stack.pop_back();
+                    removeTopState();
                 break;
                 
             case Clear:
-                m_stack.clear();
+                while (!m_stack.empty())
+                    removeTopState();
                 break;
         }
     }
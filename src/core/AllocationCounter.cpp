@@ -0,0 +1,42 @@
+#include "core/AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replacements for the global allocation functions. Only the plain and nothrow
+// forms are counted; the over-aligned ones keep their library versions, which
+// free with their own matching deallocator.
+namespace {
+    std::atomic<std::uint64_t> g_allocations(0);
+
+    void* countedAlloc(std::size_t size) noexcept {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size > 0 ? size : 1);
+    }
+
+    void* countedAllocOrThrow(std::size_t size) {
+        while (true) {
+            if (void* ptr = countedAlloc(size)) return ptr;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+std::uint64_t AllocationCounter::count() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) { return countedAllocOrThrow(size); }
+void* operator new[](std::size_t size) { return countedAllocOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
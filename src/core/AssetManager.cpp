@@ -1,6 +1,10 @@
 #include "core/AssetManager.h"
+#include "core/Profiler.h"
+#include "core/JobSystem.h"
+#include "Constants.h"
 #include <iostream>
 #include <algorithm>
+#include <vector>
 
 AssetManager::AssetManager() {
     createDefaultAssets();
@@ -66,6 +70,22 @@ void AssetManager::loadTexture(const std::string& id, const std::string& filenam
     m_textures[id] = std::move(texture);
 }
 
+void AssetManager::prewarmGlyphs() {
+    PROFILE_SCOPE("AssetManager::prewarmGlyphs");
+    std::vector<const sf::Font*> fonts = { m_defaultFont.get() };
+    for (const auto& entry : m_gameFonts) fonts.push_back(entry.second.get());
+    for (const auto& entry : m_fonts) fonts.push_back(entry.second.get());
+
+    for (const sf::Font* font : fonts) {
+        for (unsigned int size : Constants::UI_FONT_SIZES) {
+            for (sf::Uint32 codePoint = 32; codePoint < 127; ++codePoint) {
+                font->getGlyph(codePoint, size, false);
+                font->getGlyph(codePoint, size, true);
+            }
+        }
+    }
+}
+
 const sf::Font& AssetManager::getDefaultFont() {
     return *m_defaultFont;
 }
@@ -97,40 +117,76 @@ void AssetManager::createDefaultAssets() {
     m_defaultTexture->loadFromImage(whitePixel);
 }
 // Game asset loading implementation
-void AssetManager::loadAll() {
-    // Load map textures (normal loading)
-    loadGameTexture("player_map",      "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\pikachu.png");
-    loadGameTexture("tile_rock",       "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\rock.png");
-    loadGameTexture("tile_portal",     "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\warp.png");
-
-    // Load combat sprites with transparency (remove white background)
-    loadTransparentTexture("player_combat",   "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\pikachu.png");
-    loadTransparentTexture("monster_bisasam", "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\bisasam.png");
-    loadTransparentTexture("monster_chalamander","C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\chalamander.png");
-    loadTransparentTexture("monster_boss",    "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\boss.png");
+void AssetManager::loadAll(JobSystem& jobs) {
+    PROFILE_SCOPE("AssetManager::loadAll");
+
+    struct TextureSource {
+        const char* key;
+        const char* path;
+        bool transparent;   // Combat sprites: white background masked out
+    };
+
+    static const TextureSource textures[] = {
+        // Map textures
+        { "player_map",          "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\pikachu.png",     false },
+        { "tile_rock",           "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\rock.png",        false },
+        { "tile_portal",         "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\warp.png",        false },
+
+        // Combat sprites
+        { "player_combat",       "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\pikachu.png",     true },
+        { "monster_bisasam",     "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\bisasam.png",     true },
+        { "monster_chalamander", "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\chalamander.png", true },
+        { "monster_boss",        "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\boss.png",        true },
+
+        // Combat background
+        { "bg_combat",           "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\background.png",  false },
+    };
+    constexpr std::size_t textureCount = sizeof(textures) / sizeof(textures[0]);
+
+    // File reads, PNG decode and masking only touch sf::Image, so they run on
+    // the workers; the GPU upload has to stay on the main thread's GL context
+    std::vector<sf::Image> images(textureCount);
+    std::vector<char> decoded(textureCount, 0);
+    jobs.parallelFor(textureCount, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            PROFILE_SCOPE("AssetManager::decodeImage");
+            decoded[i] = images[i].loadFromFile(textures[i].path);
+            if (decoded[i] && textures[i].transparent) {
+                images[i].createMaskFromColor(sf::Color::White, 0);
+            }
+        }
+    });
 
-    // Combat background
-    loadGameTexture("bg_combat",       "C:\\Users\\Admin\\Downloads\\PROJECT\\assets\\icon\\background.png");
+    for (std::size_t i = 0; i < textureCount; ++i) {
+        uploadGameTexture(textures[i].key, textures[i].path, decoded[i] ? &images[i] : nullptr, textures[i].transparent);
+    }
 
     // Load fonts
     loadGameFont("arial",              "C:\\Windows\\Fonts\\arial.ttf");
 }
 
 void AssetManager::loadGameTexture(const std::string& key, const std::string& path) {
+    sf::Image image;
+    bool decoded = image.loadFromFile(path);
+    uploadGameTexture(key, path, decoded ? &image : nullptr, false);
+}
+
+void AssetManager::uploadGameTexture(const std::string& key, const std::string& path, const sf::Image* image, bool transparent) {
     auto texture = std::make_unique<sf::Texture>();
-    if (texture->loadFromFile(path)) {
+    if (image && texture->loadFromImage(*image)) {
         texture->setSmooth(true);
         m_gameTextures[key] = std::move(texture);
-        std::cout << "Loaded texture: " << key << " from " << path << std::endl;
-    } else {
-        std::cerr << "Warning: Failed to load texture " << key << " from " << path << std::endl;
-        // Create placeholder texture
-        auto placeholder = std::make_unique<sf::Texture>();
-        sf::Image placeholderImage;
-        placeholderImage.create(64, 64, sf::Color::Magenta);  // Magenta placeholder
-        placeholder->loadFromImage(placeholderImage);
-        m_gameTextures[key] = std::move(placeholder);
+        std::cout << (transparent ? "Loaded transparent texture: " : "Loaded texture: ") << key << " from " << path << std::endl;
+        return;
     }
+
+    std::cerr << "Warning: Failed to load " << (transparent ? "transparent texture " : "texture ") << key << " from " << path << std::endl;
+    // Create placeholder texture
+    auto placeholder = std::make_unique<sf::Texture>();
+    sf::Image placeholderImage;
+    placeholderImage.create(64, 64, sf::Color::Magenta);  // Magenta placeholder
+    placeholder->loadFromImage(placeholderImage);
+    m_gameTextures[key] = std::move(placeholder);
 }
 
 const sf::Texture& AssetManager::getGameTexture(const std::string& key) {
@@ -248,31 +304,10 @@ bool AssetManager::hasGameFont(const std::string& key) const {
 
 void AssetManager::loadTransparentTexture(const std::string& key, const std::string& path) {
     sf::Image image;
-    if (image.loadFromFile(path)) {
+    bool decoded = image.loadFromFile(path);
+    if (decoded) {
         // Create mask from white color to make it transparent
         image.createMaskFromColor(sf::Color::White, 0);
-
-        auto texture = std::make_unique<sf::Texture>();
-        if (texture->loadFromImage(image)) {
-            texture->setSmooth(true);
-            m_gameTextures[key] = std::move(texture);
-            std::cout << "Loaded transparent texture: " << key << " from " << path << std::endl;
-        } else {
-            std::cerr << "Warning: Failed to create texture from image " << key << std::endl;
-            // Create placeholder
-            auto placeholder = std::make_unique<sf::Texture>();
-            sf::Image placeholderImage;
-            placeholderImage.create(64, 64, sf::Color::Magenta);
-            placeholder->loadFromImage(placeholderImage);
-            m_gameTextures[key] = std::move(placeholder);
-        }
-    } else {
-        std::cerr << "Warning: Failed to load transparent texture " << key << " from " << path << std::endl;
-        // Create placeholder
-        auto placeholder = std::make_unique<sf::Texture>();
-        sf::Image placeholderImage;
-        placeholderImage.create(64, 64, sf::Color::Magenta);
-        placeholder->loadFromImage(placeholderImage);
-        m_gameTextures[key] = std::move(placeholder);
     }
+    uploadGameTexture(key, path, decoded ? &image : nullptr, true);
 }
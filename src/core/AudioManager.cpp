@@ -1,69 +1,143 @@
 #include "core/AudioManager.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 AudioManager::AudioManager()
-    : m_masterVolume(100.0f)
+    : m_activeDeck(0)
+    , m_fading(false)
+    , m_fadeElapsed(sf::Time::Zero)
+    , m_fadeDuration(sf::Time::Zero)
+    , m_queuedLoop(true)
+    , m_queuedFade(sf::Time::Zero)
+    , m_playCounter(0)
+    , m_masterVolume(100.0f)
     , m_musicVolume(50.0f)
     , m_soundVolume(75.0f)
     , m_muted(false)
+    , m_enabled(true)
 {
+    m_soundBank.setInUseQuery([this](const sf::SoundBuffer& buffer) {
+        return isBufferPlaying(buffer);
+    });
 }
 
 AudioManager::~AudioManager() {
+    stopAllSounds();
     stopMusic();
 }
 
-void AudioManager::playMusic(const std::string& filename, bool loop) {
-    if (m_muted) return;
-    
-    if (!m_music.openFromFile(filename)) {
-        std::cerr << "Failed to load music: " << filename << std::endl;
+void AudioManager::playMusic(const std::string& filename, bool loop, sf::Time fade) {
+    if (m_muted || !m_enabled) return;
+
+    const MusicDeck& active = m_decks[m_activeDeck];
+    if (active.track == filename && active.music.getStatus() != sf::Music::Stopped) {
+        m_queuedTrack.clear();
+        return; // Already playing
+    }
+
+    collectPrefetchedMusic();
+    if (m_failedTracks.count(filename)) {
+        m_queuedTrack.clear();
         return;
     }
-    
-    m_music.setLoop(loop);
-    m_music.setVolume(m_musicVolume * m_masterVolume / 100.0f);
-    m_music.play();
+
+    auto cached = m_musicCache.find(filename);
+    if (cached == m_musicCache.end()) {
+        // Not in memory yet: load in the background and start from update()
+        prefetchMusic(filename);
+        m_queuedTrack = filename;
+        m_queuedLoop = loop;
+        m_queuedFade = fade;
+        return;
+    }
+
+    m_queuedTrack.clear();
+    startTrack(filename, cached->second, loop, fade);
+}
+
+void AudioManager::prefetchMusic(const std::string& filename) {
+    if (!m_enabled) return;
+    if (m_musicCache.count(filename) || m_musicLoads.count(filename) || m_failedTracks.count(filename)) return;
+
+    m_musicLoads[filename] = std::async(std::launch::async, [filename]() {
+        std::ifstream file(filename, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    });
 }
 
 void AudioManager::stopMusic() {
-    m_music.stop();
+    for (MusicDeck& deck : m_decks) {
+        deck.music.stop();
+        deck.track.clear();
+        deck.gain = 0.0f;
+    }
+    m_fading = false;
+    m_queuedTrack.clear();
 }
 
 void AudioManager::pauseMusic() {
-    m_music.pause();
+    for (MusicDeck& deck : m_decks) {
+        if (deck.music.getStatus() == sf::Music::Playing) {
+            deck.music.pause();
+        }
+    }
 }
 
 void AudioManager::resumeMusic() {
-    if (!m_muted) {
-        m_music.play();
+    if (m_muted) return;
+
+    for (MusicDeck& deck : m_decks) {
+        if (!deck.track.empty()) {
+            deck.music.play();
+        }
     }
 }
 
 void AudioManager::setMusicVolume(float volume) {
     m_musicVolume = std::max(0.0f, std::min(100.0f, volume));
-    m_music.setVolume(m_musicVolume * m_masterVolume / 100.0f);
+    applyMusicVolume();
 }
 
-void AudioManager::playSound(const std::string& filename) {
+void AudioManager::playSound(SoundHandle handle, Priority priority) {
     if (m_muted) return;
-    
-    loadSound(filename);
-    
-    auto found = m_soundBuffers.find(filename);
-    if (found == m_soundBuffers.end()) {
+
+    const sf::SoundBuffer* buffer = m_soundBank.acquire(handle);
+    if (!buffer) return;
+
+    Voice* voice = acquireVoice(priority);
+    if (!voice) {
+        return; // All voices busy with higher priority sounds
+    }
+
+    voice->sound.stop();
+    voice->sound.setBuffer(*buffer);
+    voice->sound.setVolume(m_soundVolume * m_masterVolume / 100.0f);
+    voice->sound.play();
+    voice->priority = priority;
+    voice->startedAt = ++m_playCounter;
+}
+
+void AudioManager::playSound(const std::string& filename) {
+    if (!m_enabled) return;
+
+    // Convenience path: resolves the handle by name on every call.
+    // Hot paths should cache the handle returned by loadSound().
+    SoundHandle handle = loadSound(filename);
+    if (handle == InvalidSound) {
         std::cerr << "Failed to find sound: " << filename << std::endl;
         return;
     }
-    
-    cleanupSounds();
-    
-    auto sound = std::make_unique<sf::Sound>();
-    sound->setBuffer(found->second);
-    sound->setVolume(m_soundVolume * m_masterVolume / 100.0f);
-    sound->play();
-    
-    m_sounds.push_back(std::move(sound));
+
+    playSound(handle);
+}
+
+void AudioManager::stopAllSounds() {
+    for (Voice& voice : m_voices) {
+        voice.sound.stop();
+    }
 }
 
 void AudioManager::setSoundVolume(float volume) {
@@ -72,7 +146,7 @@ void AudioManager::setSoundVolume(float volume) {
 
 void AudioManager::setMasterVolume(float volume) {
     m_masterVolume = std::max(0.0f, std::min(100.0f, volume));
-    m_music.setVolume(m_musicVolume * m_masterVolume / 100.0f);
+    applyMusicVolume();
 }
 
 float AudioManager::getMasterVolume() const {
@@ -92,26 +166,138 @@ bool AudioManager::isMuted() const {
     return m_muted;
 }
 
-void AudioManager::loadSound(const std::string& filename) {
-    if (m_soundBuffers.find(filename) != m_soundBuffers.end()) {
-        return; // Already loaded
+bool AudioManager::isIdle() const {
+    return !m_fading && m_musicLoads.empty() && (m_queuedTrack.empty() || m_muted);
+}
+
+void AudioManager::update(sf::Time dt) {
+    collectPrefetchedMusic();
+
+    if (!m_queuedTrack.empty() && !m_muted) {
+        auto cached = m_musicCache.find(m_queuedTrack);
+        if (cached != m_musicCache.end()) {
+            std::string track = m_queuedTrack;
+            m_queuedTrack.clear();
+            startTrack(track, cached->second, m_queuedLoop, m_queuedFade);
+        }
+    }
+
+    if (!m_fading) return;
+
+    m_fadeElapsed += dt;
+    float t = std::min(1.0f, m_fadeElapsed.asSeconds() / m_fadeDuration.asSeconds());
+
+    MusicDeck& incoming = m_decks[m_activeDeck];
+    MusicDeck& outgoing = m_decks[m_activeDeck ^ 1];
+    incoming.gain = t;
+    outgoing.gain = std::min(outgoing.gain, 1.0f - t);
+
+    if (t >= 1.0f) {
+        outgoing.music.stop();
+        outgoing.track.clear();
+        m_fading = false;
+    }
+
+    applyMusicVolume();
+}
+
+bool AudioManager::loadSoundBank(const std::vector<std::string>& manifest, JobSystem& jobs,
+                                 SoundBank::Storage storage) {
+    if (!m_enabled) return true;
+    return m_soundBank.loadManifest(manifest, storage, jobs);
+}
+
+void AudioManager::setSoundCacheCapacity(std::size_t capacity) {
+    m_soundBank.setCacheCapacity(capacity);
+}
+
+AudioManager::SoundHandle AudioManager::loadSound(const std::string& filename) {
+    if (!m_enabled) return InvalidSound;
+    return m_soundBank.load(filename);
+}
+
+AudioManager::Voice* AudioManager::acquireVoice(Priority priority) {
+    // Fixed-size scan: prefer an idle voice, otherwise steal the oldest
+    // voice with the lowest priority that does not outrank the request.
+    Voice* victim = nullptr;
+    for (Voice& voice : m_voices) {
+        if (voice.sound.getStatus() == sf::Sound::Stopped) {
+            return &voice;
+        }
+
+        if (voice.priority > priority) {
+            continue;
+        }
+
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.startedAt < victim->startedAt)) {
+            victim = &voice;
+        }
     }
-    
-    sf::SoundBuffer buffer;
-    if (!buffer.loadFromFile(filename)) {
-        std::cerr << "Failed to load sound: " << filename << std::endl;
+
+    return victim;
+}
+
+bool AudioManager::isBufferPlaying(const sf::SoundBuffer& buffer) const {
+    for (const Voice& voice : m_voices) {
+        if (voice.sound.getBuffer() == &buffer && voice.sound.getStatus() != sf::Sound::Stopped) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioManager::startTrack(const std::string& filename, TrackData data, bool loop, sf::Time fade) {
+    // Opening from memory only parses the header; streaming runs on SFML's own thread
+    MusicDeck& deck = m_decks[m_activeDeck ^ 1];
+    if (!deck.music.openFromMemory(data->data(), data->size())) {
+        std::cerr << "Failed to load music: " << filename << std::endl;
+        m_failedTracks.insert(filename);
+        m_musicCache.erase(filename);
         return;
     }
-    
-    m_soundBuffers[filename] = std::move(buffer);
+
+    m_activeDeck ^= 1;
+    deck.data = std::move(data);
+    deck.track = filename;
+    deck.music.setLoop(loop);
+
+    m_fading = fade > sf::Time::Zero;
+    m_fadeElapsed = sf::Time::Zero;
+    m_fadeDuration = fade;
+    deck.gain = m_fading ? 0.0f : 1.0f;
+
+    if (!m_fading) {
+        MusicDeck& outgoing = m_decks[m_activeDeck ^ 1];
+        outgoing.music.stop();
+        outgoing.track.clear();
+    }
+
+    applyMusicVolume();
+    deck.music.play();
+}
+
+void AudioManager::collectPrefetchedMusic() {
+    for (auto it = m_musicLoads.begin(); it != m_musicLoads.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+
+        std::vector<char> bytes = it->second.get();
+        if (bytes.empty()) {
+            std::cerr << "Failed to load music: " << it->first << std::endl;
+            m_failedTracks.insert(it->first);
+            if (m_queuedTrack == it->first) m_queuedTrack.clear();
+        } else {
+            m_musicCache[it->first] = std::make_shared<const std::vector<char>>(std::move(bytes));
+        }
+        it = m_musicLoads.erase(it);
+    }
 }
 
-void AudioManager::cleanupSounds() {
-    m_sounds.erase(
-        std::remove_if(m_sounds.begin(), m_sounds.end(),
-            [](const std::unique_ptr<sf::Sound>& sound) {
-                return sound->getStatus() == sf::Sound::Stopped;
-            }),
-        m_sounds.end()
-    );
+void AudioManager::applyMusicVolume() {
+    for (MusicDeck& deck : m_decks) {
+        deck.music.setVolume(m_musicVolume * m_masterVolume / 100.0f * deck.gain);
+    }
 }
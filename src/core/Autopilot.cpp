@@ -0,0 +1,70 @@
+#include "core/Autopilot.h"
+
+Autopilot::Autopilot(EventBus& events, unsigned int seed)
+    : m_events(events)
+    , m_choices(seed)
+    , m_stats()
+    , m_combatStep(0)
+    , m_turnSub(0)
+    , m_combatSub(0)
+{
+    m_turnSub = m_events.subscribe(GameEvent::Type::TurnCompleted, [this](const GameEvent&) {
+        ++m_stats.turns;
+    });
+    m_combatSub = m_events.subscribe(GameEvent::Type::CombatEnded, [this](const GameEvent& event) {
+        ++m_stats.combats;
+        if (event.combatEnded.result == CombatResult::Victory) {
+            ++m_stats.victories;
+        } else {
+            ++m_stats.defeats;
+        }
+    });
+}
+
+Autopilot::~Autopilot() {
+    m_events.unsubscribe(m_turnSub);
+    m_events.unsubscribe(m_combatSub);
+}
+
+bool Autopilot::nextEvent(StateID topState, sf::Event& event) {
+    switch (topState) {
+        case StateID::Map:
+            // Ignored by the map while the auto-path is still walking
+            event = keyPress(sf::Keyboard::Enter);
+            return true;
+
+        case StateID::Combat: {
+            // Cycle through every combat input; the state ignores keys that
+            // do not apply to its current phase
+            int step = m_combatStep++ % 3;
+            if (step == 0) {
+                event = keyPress(m_choices.flipCoin() ? sf::Keyboard::H : sf::Keyboard::T);
+            } else if (step == 1) {
+                event = keyPress(static_cast<sf::Keyboard::Key>(sf::Keyboard::Num1 + m_choices.rollRange(0, 2)));
+            } else {
+                event = keyPress(sf::Keyboard::Space);
+            }
+            return true;
+        }
+
+        case StateID::Victory:
+        case StateID::GameOver:
+            return false; // The headless loop restarts the game itself
+
+        default:
+            // Menus and overlays: accept the selected entry
+            event = keyPress(sf::Keyboard::Enter);
+            return true;
+    }
+}
+
+sf::Event Autopilot::keyPress(sf::Keyboard::Key key) {
+    sf::Event event;
+    event.type = sf::Event::KeyPressed;
+    event.key.code = key;
+    event.key.alt = false;
+    event.key.control = false;
+    event.key.shift = false;
+    event.key.system = false;
+    return event;
+}
@@ -0,0 +1,456 @@
+#include "core/CombatEngine.h"
+#include "core/FastRNG.h"
+#include "core/RNG.h"
+#include "core/ScriptedRNG.h"
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<CombatEngine::State>::value,
+              "Combat state is copied freely by simulations and search");
+
+namespace {
+    constexpr int ChargeAtkBonus = 10;
+
+    // Rolls over at most this many values are picks compared for equality and
+    // get one outcome per value; wider ones are percent rolls
+    constexpr int SmallRollSpan = 6;
+
+    // The active bits, then 2 bits of stun duration, 1 of guard duration and
+    // 6 of ATK bonus: plenty for the statuses in play. The ATK bonus lasts
+    // until used, so its duration says nothing
+    constexpr int StatusKeyWidth = StatusSet::Count + 9;
+    static_assert(StatusKeyWidth == 12, "packKey keeps the statuses in bits 20-43");
+
+    std::uint64_t statusBits(const StatusSet& status) {
+        return static_cast<std::uint64_t>(status.getActive())
+             | static_cast<std::uint64_t>(status.getDuration(StatusSet::Stun) & 0x3) << StatusSet::Count
+             | static_cast<std::uint64_t>(status.getDuration(StatusSet::Guard) & 0x1) << (StatusSet::Count + 2)
+             | static_cast<std::uint64_t>(status.getMagnitude(StatusSet::ATKBonus) & 0x3F) << (StatusSet::Count + 3);
+    }
+
+    void takeDamage(CombatEngine::Fighter& fighter, int damage) {
+        fighter.hp -= damage;
+        if (fighter.hp < 0) fighter.hp = 0;
+    }
+
+    // The damage pipeline: a hit is raised by the attacker's statuses, then
+    // lowered by the target's before it lands
+    int outgoingDamage(CombatEngine::Fighter& attacker, int damage) {
+        return damage + attacker.status.consume(StatusSet::ATKBonus);
+    }
+
+    int incomingDamage(const CombatEngine::Fighter& target, int damage) {
+        if (target.status.has(StatusSet::Guard)) {
+            damage = static_cast<int>(damage * CombatEngine::GuardReduction);
+        }
+        return damage;
+    }
+
+    // Returns what was dealt
+    int dealDamage(CombatEngine::Fighter& target, int damage) {
+        damage = incomingDamage(target, damage);
+        takeDamage(target, damage);
+        return damage;
+    }
+}
+
+CombatEngine::CombatEngine()
+    : m_state(makeDefaultState())
+{
+}
+
+CombatEngine::CombatEngine(const State& state)
+    : m_state(state)
+{
+}
+
+CombatEngine::State CombatEngine::makeDefaultState() {
+    State state;
+    state.player = Fighter{100, 100, 15, 10, 0, StatusSet()};
+    state.enemy = Fighter{80, 80, 12, 8, 0, StatusSet()};
+    state.phase = Phase::CoinChoice;
+    state.defending = false;
+    state.skillMenu = false;
+    state.coinHead = false;
+    state.coinCorrect = false;
+    state.enemyMove = EnemyMove::Attack;
+    return state;
+}
+
+CombatEngine::State CombatEngine::makeEncounterState(Encounter encounter) {
+    return makeEncounterState(encounter, EncounterStats());
+}
+
+CombatEngine::State CombatEngine::makeEncounterState(Encounter encounter, const EncounterStats& stats) {
+    State state = makeDefaultState();
+    switch (encounter) {
+        case Encounter::Chalamander:
+            state.enemy = Fighter{stats.enemyHp, stats.enemyHp, stats.enemyAtk, stats.enemyDef,
+                                  stats.enemyMp, StatusSet()};
+            break;
+
+        case Encounter::Bisasam:
+            // Same offsets as Bisasam::setupBisasam
+            state.enemy = Fighter{stats.enemyHp + 5, stats.enemyHp + 5, stats.enemyAtk - 2, stats.enemyDef + 2,
+                                  stats.enemyMp - 5, StatusSet()};
+            break;
+
+        case Encounter::Boss:
+            state.enemy = Fighter{stats.bossHp, stats.bossHp, stats.bossAtk, stats.bossDef,
+                                  stats.bossMp, StatusSet()};
+            break;
+    }
+    return state;
+}
+
+void CombatEngine::reset(const State& state) {
+    m_state = state;
+}
+
+bool CombatEngine::canStep(Action action) const {
+    switch (action) {
+        case Action::CallHead:
+        case Action::CallTail:
+            return m_state.phase == Phase::CoinChoice;
+        case Action::Attack:
+            return m_state.phase == Phase::Action;
+        default:
+            // The menu stays usable whatever the phase, as it always has
+            return m_state.skillMenu;
+    }
+}
+
+std::size_t CombatEngine::enumerateOutcomes(const State& state, Action action, Outcomes& outcomes) {
+    struct Branch {
+        std::array<int, ScriptedRNG::MaxRolls> rolls;
+        std::size_t count;
+        double probability;
+    };
+
+    static const std::array<int, ChanceThresholds.size()> thresholds = [] {
+        std::array<int, ChanceThresholds.size()> sorted = ChanceThresholds;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }();
+
+    CombatEngine engine(state);
+    std::array<Branch, MaxOutcomes * 2> pending;
+    std::size_t pendingCount = 0;
+    std::size_t count = 0;
+    pending[pendingCount++] = Branch{{}, 0, 1.0};
+
+    while (pendingCount > 0) {
+        Branch branch = pending[--pendingCount];
+        ScriptedRNG rng(branch.rolls, branch.count);
+        engine.reset(state);
+        engine.step(action, rng);
+
+        if (!rng.isExhausted()) {
+            if (count == MaxOutcomes) {
+                std::cerr << "CombatEngine: too many outcomes for one step" << std::endl;
+                break;
+            }
+            outcomes[count++] = Outcome{engine.getState(), branch.probability};
+            continue;
+        }
+
+        // Replay once per distinct result of the first unscripted roll
+        int min = rng.getPendingMin();
+        int max = rng.getPendingMax();
+        double span = max - min + 1;
+        auto extend = [&](int roll, int width) {
+            if (branch.count == ScriptedRNG::MaxRolls || pendingCount == pending.size()) {
+                std::cerr << "CombatEngine: too many rolls for one step" << std::endl;
+                return;
+            }
+            Branch next = branch;
+            next.rolls[next.count++] = roll;
+            next.probability *= width / span;
+            pending[pendingCount++] = next;
+        };
+
+        if (max - min + 1 <= SmallRollSpan) {
+            for (int roll = min; roll <= max; ++roll) {
+                extend(roll, 1);
+            }
+        } else {
+            // Each stretch between thresholds behaves alike; its top value stands in for it
+            int low = min;
+            for (int threshold : thresholds) {
+                if (threshold >= low && threshold < max) {
+                    extend(threshold, threshold - low + 1);
+                    low = threshold + 1;
+                }
+            }
+            extend(max, max - low + 1);
+        }
+    }
+    return count;
+}
+
+bool CombatEngine::canUseEnemyMove(EnemyMove move) const {
+    switch (move) {
+        case EnemyMove::PowerStrike: return m_state.enemy.mp >= PowerStrikeCost;
+        case EnemyMove::Guard:       return m_state.enemy.mp >= GuardCost;
+        default:                     return true;
+    }
+}
+
+bool CombatEngine::setEnemyMove(EnemyMove move) {
+    if (!canUseEnemyMove(move)) return false;
+    m_state.enemyMove = move;
+    return true;
+}
+
+std::uint64_t CombatEngine::packKey(const State& state) {
+    // How the coin landed only matters on the result screen it leads to
+    bool onResult = state.phase == Phase::Action;
+    return static_cast<std::uint64_t>(state.player.hp & 0x3FF)
+         | static_cast<std::uint64_t>(state.enemy.hp & 0x3FF) << 10
+         | statusBits(state.player.status) << 20
+         | statusBits(state.enemy.status) << (20 + StatusKeyWidth)
+         | static_cast<std::uint64_t>(state.phase) << 44
+         | static_cast<std::uint64_t>(state.defending) << 46
+         | static_cast<std::uint64_t>(state.skillMenu) << 47
+         | static_cast<std::uint64_t>(onResult && state.coinCorrect) << 48
+         | static_cast<std::uint64_t>(state.enemyMove) << 49
+         | static_cast<std::uint64_t>(state.enemy.mp & 0x7F) << 51;
+}
+
+bool CombatEngine::sameStats(const State& a, const State& b) {
+    return a.player.maxHp == b.player.maxHp && a.player.atk == b.player.atk && a.player.def == b.player.def
+        && a.enemy.maxHp == b.enemy.maxHp && a.enemy.atk == b.enemy.atk && a.enemy.def == b.enemy.def;
+}
+
+template <typename Rng>
+CombatEngine::StepResult CombatEngine::step(Action action, Rng& rng) {
+    StepResult result;
+    result.accepted = canStep(action);
+    result.eventCount = 0;
+    if (!result.accepted) return result;
+
+    switch (action) {
+        case Action::CallHead:
+        case Action::CallTail:
+            resolveCall(action == Action::CallHead, rng, result);
+            break;
+
+        case Action::Attack:
+            strike(result);
+            break;
+
+        default: {
+            int index = static_cast<int>(action) - static_cast<int>(Action::Skill1);
+            if (m_state.defending) {
+                applyDefenseSkill(static_cast<PikaDefSkill>(index), result);
+            } else {
+                applyAttackSkill(static_cast<PikaAtkSkill>(index), rng, result);
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+void CombatEngine::forceResult(bool victory) {
+    m_state.phase = victory ? Phase::Victory : Phase::Defeat;
+}
+
+template <typename Rng>
+void CombatEngine::resolveCall(bool head, Rng& rng, StepResult& result) {
+    m_state.coinHead = rng.rollRange(1, 2) == 1;
+    m_state.coinCorrect = head == m_state.coinHead;
+    emit(result, Event::CoinLanded);
+
+    if (m_state.defending) {
+        if (m_state.coinCorrect) {
+            m_state.skillMenu = true;
+            emit(result, Event::DefenseCallRight);
+        } else {
+            emit(result, Event::DefenseCallWrong);
+            if (rng.rollRange(1, 100) <= DodgeChance) {
+                emit(result, Event::EnemyDodged);
+            } else {
+                enemyAttack(result);
+            }
+        }
+    } else if (m_state.coinCorrect) {
+        m_state.skillMenu = true;
+    } else {
+        m_state.player.status.tick();
+        int damage = dealDamage(m_state.enemy, outgoingDamage(m_state.player, m_state.player.atk));
+        emit(result, Event::NormalAttack, damage);
+
+        checkEnd(result);
+        if (!isOver()) {
+            beginEnemyTurn(result);
+        }
+    }
+
+    // The result screen always follows a flip, even one that decided the
+    // battle: the ending then waits for the next action to confirm it
+    m_state.phase = Phase::Action;
+}
+
+template <typename Rng>
+void CombatEngine::applyAttackSkill(PikaAtkSkill skill, Rng& rng, StepResult& result) {
+    Fighter& player = m_state.player;
+    Fighter& enemy = m_state.enemy;
+    int damage = 0;
+    bool stunned = false;
+    player.status.tick();
+
+    switch (skill) {
+        case PikaAtkSkill::Thunderbolt:
+            damage = static_cast<int>(player.atk * 2.0f);
+            stunned = rng.rollRange(1, 100) <= StunChance;
+            if (stunned) {
+                emit(result, Event::EnemyStunned);
+            }
+            break;
+
+        case PikaAtkSkill::ElectroBall:
+            // Hits harder the more HP the enemy has already lost
+            damage = player.atk + static_cast<int>(0.15f * (enemy.maxHp - enemy.hp));
+            break;
+
+        case PikaAtkSkill::VoltTackle: {
+            damage = static_cast<int>(player.atk * 2.5f);
+            int recoil = static_cast<int>(damage * 0.1f);
+            takeDamage(player, recoil);
+            emit(result, Event::Recoil, recoil);
+            break;
+        }
+    }
+
+    damage = dealDamage(enemy, outgoingDamage(player, damage));
+    emit(result, Event::SkillAttack, damage, static_cast<std::uint8_t>(skill));
+    // After the hit, which a guard already softened; the guard runs out with
+    // the turn the stun costs
+    if (stunned) {
+        enemy.status.apply(StatusSet::Stun, 1);
+    }
+
+    m_state.skillMenu = false;
+    checkEnd(result);
+    if (!isOver()) {
+        beginEnemyTurn(result);
+    }
+}
+
+void CombatEngine::applyDefenseSkill(PikaDefSkill skill, StepResult& result) {
+    int damage = resolveEnemyMove(result);
+
+    switch (skill) {
+        case PikaDefSkill::QuickGuard:
+            damage = static_cast<int>(damage * 0.5f);
+            break;
+
+        case PikaDefSkill::Agility:
+            damage = 0;
+            break;
+
+        case PikaDefSkill::Charge:
+            damage = static_cast<int>(damage * 0.7f);
+            m_state.player.status.apply(StatusSet::ATKBonus, StatusSet::UntilUsed, ChargeAtkBonus);
+            break;
+    }
+    emit(result, Event::DefenseSkill, 0, static_cast<std::uint8_t>(skill));
+
+    damage = dealDamage(m_state.player, damage);
+    if (damage > 0) {
+        emit(result, Event::PlayerDamaged, damage);
+    }
+
+    m_state.skillMenu = false;
+    checkEnd(result);
+    if (!isOver()) {
+        m_state.phase = Phase::CoinChoice;
+    }
+}
+
+void CombatEngine::strike(StepResult& result) {
+    // A strike does not spend the ATK bonus
+    m_state.player.status.tick();
+    int damage = dealDamage(m_state.enemy, m_state.coinCorrect ? m_state.player.atk * 2 : m_state.player.atk);
+    emit(result, Event::Strike, damage, m_state.coinCorrect ? 1 : 0);
+
+    checkEnd(result);
+    if (!isOver()) {
+        enemyAttack(result);
+    }
+}
+
+void CombatEngine::enemyAttack(StepResult& result) {
+    bool guarding = m_state.enemyMove == EnemyMove::Guard;
+    int damage = resolveEnemyMove(result);
+    if (!guarding) {
+        damage = dealDamage(m_state.player, damage);
+        emit(result, Event::EnemyAttack, damage);
+    }
+
+    checkEnd(result);
+    if (!isOver()) {
+        m_state.phase = Phase::CoinChoice;
+    }
+}
+
+void CombatEngine::beginEnemyTurn(StepResult& result) {
+    StatusSet& status = m_state.enemy.status;
+    if (status.has(StatusSet::Stun)) {
+        emit(result, Event::EnemyLostTurn);
+        status.tick();
+        m_state.phase = Phase::CoinChoice;
+        return;
+    }
+
+    // The player calls the coin again, this time to defend
+    emit(result, Event::EnemyTurn);
+    m_state.phase = Phase::CoinChoice;
+    m_state.defending = true;
+}
+
+int CombatEngine::resolveEnemyMove(StepResult& result) {
+    Fighter& enemy = m_state.enemy;
+    // The enemy's turn starts here unless a stun took it; a guard runs out
+    enemy.status.tick();
+
+    EnemyMove move = m_state.enemyMove;
+    m_state.enemyMove = EnemyMove::Attack;
+    switch (move) {
+        case EnemyMove::PowerStrike:
+            enemy.mp -= PowerStrikeCost;
+            emit(result, Event::EnemyPowerStrike);
+            return static_cast<int>(enemy.atk * PowerStrikeMultiplier);
+
+        case EnemyMove::Guard:
+            enemy.mp -= GuardCost;
+            enemy.status.apply(StatusSet::Guard, 1);
+            emit(result, Event::EnemyGuard);
+            return 0;
+
+        default:
+            return enemy.atk;
+    }
+}
+
+void CombatEngine::checkEnd(StepResult& result) {
+    if (m_state.enemy.hp <= 0) {
+        m_state.phase = Phase::Victory;
+        emit(result, Event::Victory);
+    } else if (m_state.player.hp <= 0) {
+        m_state.phase = Phase::Defeat;
+        emit(result, Event::Defeat);
+    }
+}
+
+void CombatEngine::emit(StepResult& result, Event::Type type, int amount, std::uint8_t skill) {
+    if (result.eventCount < MaxEvents) {
+        result.events[result.eventCount++] = Event{type, skill, amount};
+    }
+}
+
+template CombatEngine::StepResult CombatEngine::step<RNG>(Action, RNG&);
+template CombatEngine::StepResult CombatEngine::step<FastRNG>(Action, FastRNG&);
+template CombatEngine::StepResult CombatEngine::step<ScriptedRNG>(Action, ScriptedRNG&);
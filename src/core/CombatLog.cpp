@@ -0,0 +1,174 @@
+#include "core/CombatLog.h"
+#ifdef ENABLE_COMBAT_EXPORT
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#endif
+
+namespace {
+    using Event = CombatEngine::Event;
+
+    std::int16_t clampShort(int value) {
+        if (value > INT16_MAX) return INT16_MAX;
+        if (value < INT16_MIN) return INT16_MIN;
+        return static_cast<std::int16_t>(value);
+    }
+
+    std::uint8_t actorOf(Event::Type type) {
+        switch (type) {
+            case Event::NormalAttack:
+            case Event::Strike:
+            case Event::SkillAttack:
+            case Event::Recoil:
+            case Event::DefenseCallRight:
+            case Event::DefenseCallWrong:
+            case Event::DefenseSkill:
+                return CombatLogEntry::Player;
+            case Event::EnemyStunned:
+            case Event::EnemyLostTurn:
+            case Event::EnemyDodged:
+            case Event::EnemyAttack:
+            case Event::PlayerDamaged:
+            case Event::EnemyPowerStrike:
+            case Event::EnemyGuard:
+                return CombatLogEntry::Enemy;
+            default:
+                return CombatLogEntry::System;
+        }
+    }
+
+    bool duringEnemyTurn(Event::Type type) {
+        switch (type) {
+            case Event::DefenseCallRight:
+            case Event::DefenseCallWrong:
+            case Event::DefenseSkill:
+            case Event::EnemyAttack:
+            case Event::PlayerDamaged:
+            case Event::EnemyPowerStrike:
+            case Event::EnemyGuard:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+#ifdef ENABLE_COMBAT_EXPORT
+    const char Magic[4] = {'E', 'O', 'C', 'L'};
+    constexpr std::uint16_t Version = 2;     // 2: hint entries carry their own fields
+
+    template <typename T>
+    void writeRaw(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+#endif
+}
+
+CombatLog::CombatLog()
+    : m_entries()
+    , m_next(0)
+    , m_count(0)
+    , m_total(0)
+    , m_turn(0)
+{
+}
+
+void CombatLog::clear() {
+    m_next = 0;
+    m_count = 0;
+    m_total = 0;
+    m_turn = 0;
+#ifdef ENABLE_COMBAT_EXPORT
+    m_battle.clear();
+#endif
+}
+
+void CombatLog::pushStep(const CombatEngine::StepResult& result, const CombatEngine::State& after) {
+    for (std::uint8_t i = 0; i < result.eventCount; ++i) {
+        const Event& event = result.events[i];
+        CombatLogEntry entry = makeEntry(event.type, after);
+        entry.turn = m_turn;
+        entry.actor = actorOf(event.type);
+        entry.skill = event.type == Event::CoinLanded ? static_cast<std::uint8_t>(after.coinHead) : event.skill;
+        entry.damage = clampShort(event.amount);
+
+        entry.flags = 0;
+        if (duringEnemyTurn(event.type)) entry.flags |= CombatLogEntry::Defending;
+        if (event.type == Event::Strike && event.skill) entry.flags |= CombatLogEntry::Crit;
+        if (event.type == Event::EnemyDodged) entry.flags |= CombatLogEntry::Dodged;
+        if (event.type == Event::DefenseSkill && event.skill == static_cast<std::uint8_t>(PikaDefSkill::Agility)) {
+            entry.flags |= CombatLogEntry::Dodged;
+        }
+        push(entry);
+    }
+    ++m_turn;
+}
+
+void CombatLog::push(const CombatLogEntry& entry) {
+    m_entries[m_next] = entry;
+    m_next = (m_next + 1) % Capacity;
+    if (m_count < Capacity) ++m_count;
+    ++m_total;
+
+#ifdef ENABLE_COMBAT_EXPORT
+    m_battle.push_back(entry);
+#endif
+}
+
+const CombatLogEntry& CombatLog::fromNewest(std::size_t index) const {
+    return m_entries[(m_next + Capacity - 1 - index) % Capacity];
+}
+
+CombatLogEntry CombatLog::makeEntry(std::uint8_t kind, const CombatEngine::State& state) {
+    CombatLogEntry entry{};
+    entry.kind = kind;
+    entry.actor = CombatLogEntry::System;
+    entry.flags = state.defending ? CombatLogEntry::Defending : 0;
+    entry.playerStatus = state.player.status.getActive();
+    entry.enemyStatus = state.enemy.status.getActive();
+    entry.playerHp = clampShort(state.player.hp);
+    entry.enemyHp = clampShort(state.enemy.hp);
+    return entry;
+}
+
+#ifdef ENABLE_COMBAT_EXPORT
+bool CombatLog::appendBattle(const std::string& filename, std::uint32_t session, std::uint8_t monster,
+                             std::uint8_t result) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::app);
+    if (!file) {
+        std::cerr << "CombatLog: Cannot open " << filename << " for writing" << std::endl;
+        return false;
+    }
+
+    file.seekp(0, std::ios::end);
+    if (file.tellp() == 0) {
+        file.write(Magic, sizeof(Magic));
+        writeRaw(file, Version);
+    } else {
+        // Entries of another layout would be misread with this file's header
+        std::ifstream existing(filename, std::ios::binary);
+        char magic[sizeof(Magic)] = {};
+        std::uint16_t version = 0;
+        existing.read(magic, sizeof(magic));
+        existing.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (!existing || !std::equal(magic, magic + sizeof(magic), Magic) || version != Version) {
+            std::cerr << "CombatLog: " << filename << " is not a version " << Version
+                      << " combat log; not appending" << std::endl;
+            return false;
+        }
+    }
+
+    writeRaw(file, session);
+    writeRaw(file, monster);
+    writeRaw(file, result);
+    writeRaw(file, std::uint16_t(0));
+    writeRaw(file, static_cast<std::uint32_t>(m_battle.size()));
+    file.write(reinterpret_cast<const char*>(m_battle.data()),
+               static_cast<std::streamsize>(m_battle.size() * sizeof(CombatLogEntry)));
+
+    if (!file) {
+        std::cerr << "CombatLog: Failed writing battle to " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,189 @@
+#include "core/CombatSearch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using Action = CombatEngine::Action;
+    using EnemyMove = CombatEngine::EnemyMove;
+    using Clock = std::chrono::steady_clock;
+
+    const Action AllActions[] = {Action::CallHead, Action::CallTail, Action::Attack,
+                                 Action::Skill1, Action::Skill2, Action::Skill3};
+    const EnemyMove AllMoves[] = {EnemyMove::Attack, EnemyMove::PowerStrike, EnemyMove::Guard};
+
+    // The clock is read once per this many nodes
+    constexpr std::uint64_t ClockInterval = 256;
+
+    // Enemy-node entries share the table with player-node ones at the same state
+    constexpr std::uint64_t EnemyNodeBit = std::uint64_t(1) << 63;
+
+    std::uint64_t mix(std::uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        return key;
+    }
+}
+
+CombatSearch::CombatSearch(double playerSkill, unsigned int tableBits)
+    : m_playerSkill(playerSkill)
+    , m_table(std::size_t(1) << tableBits)
+    , m_mask((std::uint64_t(1) << tableBits) - 1)
+    , m_stats(CombatEngine::makeDefaultState())
+    , m_hasStats(false)
+    , m_start()
+    , m_nodes(0)
+    , m_aborted(false)
+{
+    clearTable();
+}
+
+CombatSearch::Result CombatSearch::chooseEnemyMove(const CombatEngine::State& state, const Limits& limits) {
+    if (!m_hasStats || !CombatEngine::sameStats(m_stats, state)) {
+        clearTable();
+        m_stats = state;
+        m_hasStats = true;
+    }
+
+    m_start = Clock::now();
+    m_nodes = 0;
+    m_aborted = false;
+
+    // Depth 0 scores each move statically and runs without limits, so there
+    // is always an answer
+    m_limits = Limits();
+    Result result;
+    result.move = EnemyMove::Attack;
+    result.playerWinChance = enemyNode(state, 0, &result.move);
+    result.depth = 0;
+
+    m_limits = limits;
+
+    for (int depth = 1; depth <= limits.maxDepth; ++depth) {
+        EnemyMove move = EnemyMove::Attack;
+        double value = enemyNode(state, depth, &move);
+        if (m_aborted) break;
+
+        result.move = move;
+        result.playerWinChance = value;
+        result.depth = depth;
+        if (value <= 0.0 || value >= 1.0) break;   // Decided either way
+    }
+
+    result.nodes = m_nodes;
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_start);
+    return result;
+}
+
+void CombatSearch::clearTable() {
+    std::fill(m_table.begin(), m_table.end(), Entry{0, 0.0f, -1, 0});
+}
+
+double CombatSearch::enemyNode(const CombatEngine::State& state, int depth, EnemyMove* bestMove) {
+    CombatEngine engine(state);
+    std::uint64_t key = CombatEngine::packKey(state) | EnemyNodeBit;
+    Entry* entry = probe(key);
+    if (entry->key == key && entry->depth >= depth && !bestMove) {
+        return entry->value;
+    }
+
+    double best = 2.0;
+    EnemyMove chosen = EnemyMove::Attack;
+    for (EnemyMove move : AllMoves) {
+        if (!engine.canUseEnemyMove(move)) continue;
+
+        CombatEngine::State next = state;
+        next.enemyMove = move;
+        double value = playerNode(next, depth);
+        if (m_aborted) return 0.0;
+        if (value < best) {
+            best = value;
+            chosen = move;
+        }
+    }
+
+    if (bestMove) *bestMove = chosen;
+    *entry = Entry{key, static_cast<float>(best), static_cast<std::int8_t>(depth), static_cast<std::uint8_t>(chosen)};
+    return best;
+}
+
+double CombatSearch::playerNode(const CombatEngine::State& state, int depth) {
+    ++m_nodes;
+    if (outOfBudget()) return 0.0;
+
+    if (state.phase == CombatEngine::Phase::Victory) return 1.0;
+    if (state.phase == CombatEngine::Phase::Defeat) return 0.0;
+    if (depth <= 0) return evaluate(state);
+
+    std::uint64_t key = CombatEngine::packKey(state);
+    Entry* entry = probe(key);
+    if (entry->key == key && entry->depth >= depth) {
+        return entry->value;
+    }
+
+    CombatEngine engine(state);
+    double best = 0.0;
+    double sum = 0.0;
+    int choices = 0;
+    std::uint8_t bestAction = 0;
+    for (Action action : AllActions) {
+        if (!engine.canStep(action)) continue;
+        // The coin is fair: calling tail is the same as calling head
+        if (action == Action::CallTail && engine.canStep(Action::CallHead)) continue;
+
+        CombatEngine::Outcomes outcomes;
+        std::size_t count = CombatEngine::enumerateOutcomes(state, action, outcomes);
+        double value = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            value += outcomes[i].probability * child(outcomes[i].state, depth - 1);
+            if (m_aborted) return 0.0;
+        }
+        sum += value;
+        ++choices;
+        if (value > best) {
+            best = value;
+            bestAction = static_cast<std::uint8_t>(action);
+        }
+    }
+
+    double value = m_playerSkill * best + (1.0 - m_playerSkill) * (choices > 0 ? sum / choices : 0.0);
+    *entry = Entry{key, static_cast<float>(value), static_cast<std::int8_t>(depth), bestAction};
+    return value;
+}
+
+double CombatSearch::child(const CombatEngine::State& state, int depth) {
+    if (state.phase == CombatEngine::Phase::CoinChoice) {
+        return enemyNode(state, depth, nullptr);
+    }
+    return playerNode(state, depth);
+}
+
+bool CombatSearch::outOfBudget() {
+    if (m_aborted) return true;
+    if (m_limits.maxNodes > 0 && m_nodes > m_limits.maxNodes) {
+        m_aborted = true;
+    } else if (m_limits.timeLimit.count() > 0 && m_nodes % ClockInterval == 0
+               && Clock::now() - m_start >= m_limits.timeLimit) {
+        m_aborted = true;
+    }
+    return m_aborted;
+}
+
+double CombatSearch::evaluate(const CombatEngine::State& state) {
+    const CombatEngine::Fighter& player = state.player;
+    const CombatEngine::Fighter& enemy = state.enemy;
+
+    // Hits each side needs, the enemy's counting the Power Strikes its MP buys
+    double playerHits = static_cast<double>(enemy.hp) / std::max(1, player.atk);
+    double strikes = std::min(static_cast<double>(enemy.mp / CombatEngine::PowerStrikeCost),
+                              static_cast<double>(player.hp) / std::max(1, enemy.atk));
+    double extra = strikes * enemy.atk * (CombatEngine::PowerStrikeMultiplier - 1.0f);
+    double enemyHits = std::max(0.0, player.hp - extra) / std::max(1, enemy.atk);
+
+    if (enemyHits + playerHits <= 0.0) return 0.5;
+    return enemyHits / (enemyHits + playerHits);
+}
+
+CombatSearch::Entry* CombatSearch::probe(std::uint64_t key) {
+    return &m_table[mix(key) & m_mask];
+}
@@ -0,0 +1,150 @@
+#include "core/CombatSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace {
+    using Action = CombatEngine::Action;
+
+    const Action AllActions[] = {Action::CallHead, Action::CallTail, Action::Attack,
+                                 Action::Skill1, Action::Skill2, Action::Skill3};
+
+    // Loops are iterated until their value moves less than this
+    constexpr double Tolerance = 1e-12;
+    constexpr int MaxIterations = 200;
+}
+
+CombatSolver::CombatSolver()
+    : m_stats(CombatEngine::makeDefaultState())
+    , m_hasStats(false)
+{
+}
+
+CombatSolver::CombatSolver(Policy policy)
+    : m_policy(std::move(policy))
+    , m_stats(CombatEngine::makeDefaultState())
+    , m_hasStats(false)
+{
+}
+
+double CombatSolver::winChance(const CombatEngine::State& state) {
+    adopt(state);
+    int low = std::numeric_limits<int>::max();
+    return value(state, 0, low);
+}
+
+double CombatSolver::actionValue(const CombatEngine::State& state, Action action) {
+    adopt(state);
+    m_engine.reset(state);
+    if (!m_engine.canStep(action)) return 0.0;
+
+    int low = std::numeric_limits<int>::max();
+    return expected(state, action, 0, low);
+}
+
+CombatSolver::Advice CombatSolver::advise(const CombatEngine::State& state) {
+    Advice best{Action::Attack, state.phase == CombatEngine::Phase::Victory ? 1.0 : 0.0};
+    bool found = false;
+    for (Action action : AllActions) {
+        m_engine.reset(state);
+        if (!m_engine.canStep(action)) continue;
+
+        double chance = actionValue(state, action);
+        if (!found || chance > best.winChance) {
+            best = Advice{action, chance};
+            found = true;
+        }
+    }
+    return best;
+}
+
+void CombatSolver::clear() {
+    m_solved.clear();
+    m_inProgress.clear();
+    m_hasStats = false;
+}
+
+void CombatSolver::adopt(const CombatEngine::State& state) {
+    if (m_hasStats && CombatEngine::sameStats(m_stats, state)) return;
+
+    clear();
+    m_stats = state;
+    m_hasStats = true;
+}
+
+double CombatSolver::value(const CombatEngine::State& state, int depth, int& low) {
+    if (state.phase == CombatEngine::Phase::Victory) return 1.0;
+    if (state.phase == CombatEngine::Phase::Defeat) return 0.0;
+
+    std::uint64_t id = CombatEngine::packKey(state);
+    auto solved = m_solved.find(id);
+    if (solved != m_solved.end()) return solved->second;
+
+    auto running = m_inProgress.find(id);
+    if (running != m_inProgress.end()) {
+        // A loop back to a state still being solved: use its current estimate
+        low = std::min(low, running->second.depth);
+        return running->second.estimate;
+    }
+
+    m_inProgress[id] = InProgress{depth, 0.0};
+    double result = 0.0;
+    int reached = std::numeric_limits<int>::max();
+    for (int iteration = 0; iteration < MaxIterations; ++iteration) {
+        reached = std::numeric_limits<int>::max();
+        result = evaluate(state, depth, reached);
+
+        InProgress& entry = m_inProgress[id];
+        double change = std::abs(result - entry.estimate);
+        entry.estimate = result;
+
+        // Only a loop back to this very state needs another pass; a loop to
+        // an outer one is iterated from there
+        if (reached != depth || change < Tolerance) break;
+    }
+    m_inProgress.erase(id);
+
+    if (reached >= depth) {
+        m_solved.emplace(id, result);
+    } else {
+        low = std::min(low, reached);
+    }
+    return result;
+}
+
+double CombatSolver::evaluate(const CombatEngine::State& state, int depth, int& low) {
+    std::array<Action, 6> actions;
+    std::size_t count = 0;
+    m_engine.reset(state);
+    for (Action action : AllActions) {
+        if (m_engine.canStep(action)) {
+            actions[count++] = action;
+        }
+    }
+
+    double result = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (m_policy) {
+            double weight = m_policy(state, actions[i]);
+            if (weight > 0.0) {
+                result += weight * expected(state, actions[i], depth, low);
+            }
+        } else {
+            result = std::max(result, expected(state, actions[i], depth, low));
+        }
+    }
+    return result;
+}
+
+double CombatSolver::expected(const CombatEngine::State& state, Action action, int depth, int& low) {
+    CombatEngine::Outcomes outcomes;
+    std::size_t count = CombatEngine::enumerateOutcomes(state, action, outcomes);
+
+    double result = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        result += outcomes[i].probability * value(outcomes[i].state, depth + 1, low);
+    }
+    return result;
+}
@@ -0,0 +1,111 @@
+#include "core/EventBus.h"
+#include <algorithm>
+#include <iostream>
+
+GameEvent GameEvent::makeCombatStarted(std::uint32_t session, MonsterType monster, Vec2i pos) {
+    GameEvent event;
+    event.type = Type::CombatStarted;
+    event.session = session;
+    event.combatStarted = CombatStartedData{monster, pos.x, pos.y};
+    return event;
+}
+
+GameEvent GameEvent::makeCombatEnded(std::uint32_t session, CombatResult result, MonsterType monster, Vec2i pos) {
+    GameEvent event;
+    event.type = Type::CombatEnded;
+    event.session = session;
+    event.combatEnded = CombatEndedData{result, monster, pos.x, pos.y};
+    return event;
+}
+
+GameEvent GameEvent::makeTileChanged(std::uint32_t session, Vec2i pos, TileType from, TileType to) {
+    GameEvent event;
+    event.type = Type::TileChanged;
+    event.session = session;
+    event.tileChanged = TileChangedData{pos.x, pos.y, from, to};
+    return event;
+}
+
+GameEvent GameEvent::makeSaveRequested(std::uint32_t session) {
+    GameEvent event;
+    event.type = Type::SaveRequested;
+    event.session = session;
+    return event;
+}
+
+GameEvent GameEvent::makeTurnCompleted(std::uint32_t session) {
+    GameEvent event;
+    event.type = Type::TurnCompleted;
+    event.session = session;
+    return event;
+}
+
+EventBus::EventBus()
+    : m_queue()
+    , m_head(0)
+    , m_count(0)
+    , m_nextID(0)
+    , m_lastSession(AnySession)
+    , m_dispatching(false)
+{
+}
+
+bool EventBus::publish(const GameEvent& event) {
+    if (m_count == Capacity) {
+        std::cerr << "EventBus: queue full, dropping event " << static_cast<int>(event.type) << std::endl;
+        return false;
+    }
+
+    m_queue[(m_head + m_count) % Capacity] = event;
+    ++m_count;
+    return true;
+}
+
+EventBus::SubscriptionID EventBus::subscribe(GameEvent::Type type, Handler handler) {
+    m_subscribers.push_back(Subscriber{++m_nextID, false, type, std::move(handler)});
+    return m_nextID;
+}
+
+EventBus::SubscriptionID EventBus::subscribeAll(Handler handler) {
+    m_subscribers.push_back(Subscriber{++m_nextID, true, GameEvent::Type::CombatStarted, std::move(handler)});
+    return m_nextID;
+}
+
+void EventBus::unsubscribe(SubscriptionID id) {
+    // Mark first: during dispatch the entry is erased once delivery finishes
+    for (Subscriber& subscriber : m_subscribers) {
+        if (subscriber.id == id) {
+            subscriber.id = 0;
+        }
+    }
+
+    if (!m_dispatching) {
+        m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+            [](const Subscriber& subscriber) { return subscriber.id == 0; }), m_subscribers.end());
+    }
+}
+
+void EventBus::dispatch() {
+    m_dispatching = true;
+
+    std::size_t pending = m_count;
+    while (pending-- > 0) {
+        GameEvent event = m_queue[m_head];
+        m_head = (m_head + 1) % Capacity;
+        --m_count;
+
+        // Index loop: handlers may subscribe and grow the list
+        for (std::size_t i = 0; i < m_subscribers.size(); ++i) {
+            Subscriber& subscriber = m_subscribers[i];
+            if (subscriber.id == 0) continue;
+            if (!subscriber.allTypes && subscriber.type != event.type) continue;
+
+            subscriber.handler(event);
+        }
+    }
+
+    m_dispatching = false;
+
+    m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+        [](const Subscriber& subscriber) { return subscriber.id == 0; }), m_subscribers.end());
+}
@@ -0,0 +1,319 @@
+#include "core/InputRecorder.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char Magic[4] = {'E', 'O', 'C', 'R'};
+    // Bumped whenever checkpoint hashes change meaning, so older logs are
+    // refused instead of reporting a false divergence
+    constexpr std::uint16_t Version = 3;
+
+    enum RecordKind : std::uint8_t {
+        RecordEvent = 1,
+        RecordCheckpoint = 2,
+        RecordEnd = 3
+    };
+
+    enum KeyModifiers : std::uint8_t {
+        ModAlt = 1 << 0,
+        ModControl = 1 << 1,
+        ModShift = 1 << 2,
+        ModSystem = 1 << 3
+    };
+}
+
+// ---------------------------------------------------------------------------
+// InputRecorder
+
+InputRecorder::InputRecorder()
+    : m_lastTick(0)
+{
+}
+
+InputRecorder::~InputRecorder() {
+    if (isOpen()) {
+        close(m_lastTick);
+    }
+}
+
+bool InputRecorder::open(const std::string& filename, std::uint32_t seed) {
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        std::cerr << "Failed to open input log: " << filename << std::endl;
+        return false;
+    }
+
+    m_file.write(Magic, sizeof(Magic));
+    for (int i = 0; i < 2; ++i) m_file.put(static_cast<char>((Version >> (8 * i)) & 0xFF));
+    for (int i = 0; i < 4; ++i) m_file.put(static_cast<char>((seed >> (8 * i)) & 0xFF));
+    m_lastTick = 0;
+    return true;
+}
+
+void InputRecorder::close(std::uint64_t finalTick) {
+    if (!isOpen()) return;
+
+    writeRecord(RecordEnd, finalTick);
+    m_file.close();
+}
+
+void InputRecorder::recordEvent(std::uint64_t tick, const sf::Event& event) {
+    if (!isOpen()) return;
+
+    switch (event.type) {
+        case sf::Event::JoystickButtonPressed:
+        case sf::Event::JoystickButtonReleased:
+        case sf::Event::JoystickMoved:
+        case sf::Event::JoystickConnected:
+        case sf::Event::JoystickDisconnected:
+        case sf::Event::TouchBegan:
+        case sf::Event::TouchMoved:
+        case sf::Event::TouchEnded:
+        case sf::Event::SensorChanged:
+            return; // No state reads these
+        default:
+            break;
+    }
+
+    writeRecord(RecordEvent, tick);
+    m_file.put(static_cast<char>(event.type));
+
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            std::uint8_t mods = (event.key.alt ? ModAlt : 0) | (event.key.control ? ModControl : 0) |
+                                (event.key.shift ? ModShift : 0) | (event.key.system ? ModSystem : 0);
+            writeSigned(event.key.code);
+            m_file.put(static_cast<char>(mods));
+            break;
+        }
+
+        case sf::Event::TextEntered:
+            writeVarint(event.text.unicode);
+            break;
+
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            writeVarint(static_cast<std::uint64_t>(event.mouseButton.button));
+            writeSigned(event.mouseButton.x);
+            writeSigned(event.mouseButton.y);
+            break;
+
+        case sf::Event::MouseMoved:
+            writeSigned(event.mouseMove.x);
+            writeSigned(event.mouseMove.y);
+            break;
+
+        case sf::Event::MouseWheelScrolled: {
+            std::uint32_t delta = 0;
+            std::memcpy(&delta, &event.mouseWheelScroll.delta, sizeof(delta));
+            writeVarint(static_cast<std::uint64_t>(event.mouseWheelScroll.wheel));
+            writeVarint(delta);
+            writeSigned(event.mouseWheelScroll.x);
+            writeSigned(event.mouseWheelScroll.y);
+            break;
+        }
+
+        case sf::Event::Resized:
+            writeVarint(event.size.width);
+            writeVarint(event.size.height);
+            break;
+
+        default:
+            break; // Closed, focus and enter/leave carry no payload
+    }
+}
+
+void InputRecorder::recordCheckpoint(std::uint64_t tick, std::uint64_t stateHash) {
+    if (!isOpen()) return;
+
+    writeRecord(RecordCheckpoint, tick);
+    for (int i = 0; i < 8; ++i) m_file.put(static_cast<char>((stateHash >> (8 * i)) & 0xFF));
+}
+
+void InputRecorder::writeRecord(std::uint8_t kind, std::uint64_t tick) {
+    m_file.put(static_cast<char>(kind));
+    writeVarint(tick - m_lastTick);
+    m_lastTick = tick;
+}
+
+void InputRecorder::writeVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        m_file.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    m_file.put(static_cast<char>(value));
+}
+
+void InputRecorder::writeSigned(std::int64_t value) {
+    // Zigzag so small negative coordinates stay one byte
+    writeVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+// ---------------------------------------------------------------------------
+// InputPlayer
+
+InputPlayer::InputPlayer()
+    : m_cursor(0)
+    , m_nextEvent(0)
+    , m_nextCheckpoint(0)
+    , m_seed(0)
+    , m_finalTick(0)
+    , m_loaded(false)
+{
+}
+
+bool InputPlayer::open(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open input log: " << filename << std::endl;
+        return false;
+    }
+
+    m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (m_data.size() < 10 || std::memcmp(m_data.data(), Magic, sizeof(Magic)) != 0) {
+        std::cerr << "Not an input log: " << filename << std::endl;
+        return false;
+    }
+
+    std::uint16_t version = static_cast<std::uint16_t>(m_data[4] | (m_data[5] << 8));
+    if (version != Version) {
+        std::cerr << "Unsupported input log version " << version << ": " << filename << std::endl;
+        return false;
+    }
+
+    m_seed = 0;
+    for (int i = 0; i < 4; ++i) m_seed |= static_cast<std::uint32_t>(m_data[6 + i]) << (8 * i);
+    m_cursor = 10;
+
+    // Decode everything up front so playback is just index walking
+    std::uint64_t tick = 0;
+    bool ended = false;
+    while (m_cursor < m_data.size() && !ended) {
+        std::uint8_t kind = m_data[m_cursor++];
+        std::uint64_t delta = 0;
+        if (!readVarint(delta)) break;
+        tick += delta;
+
+        if (kind == RecordEvent) {
+            sf::Event event = sf::Event();
+            if (!readEvent(event)) break;
+            m_events.push_back(TimedEvent{tick, event});
+        } else if (kind == RecordCheckpoint) {
+            if (m_cursor + 8 > m_data.size()) break;
+            std::uint64_t hash = 0;
+            for (int i = 0; i < 8; ++i) hash |= static_cast<std::uint64_t>(m_data[m_cursor++]) << (8 * i);
+            m_checkpoints.push_back(Checkpoint{tick, hash});
+        } else if (kind == RecordEnd) {
+            ended = true;
+        } else {
+            break;
+        }
+    }
+
+    if (!ended) {
+        std::cerr << "Input log is truncated, replaying up to tick " << tick << std::endl;
+    }
+
+    m_finalTick = tick;
+    m_data.clear();
+    m_loaded = true;
+    return true;
+}
+
+bool InputPlayer::pollEvent(std::uint64_t tick, sf::Event& event) {
+    if (m_nextEvent >= m_events.size() || m_events[m_nextEvent].tick != tick) {
+        return false;
+    }
+
+    event = m_events[m_nextEvent++].event;
+    return true;
+}
+
+bool InputPlayer::checkpointAt(std::uint64_t tick, std::uint64_t& stateHash) {
+    if (m_nextCheckpoint >= m_checkpoints.size() || m_checkpoints[m_nextCheckpoint].tick != tick) {
+        return false;
+    }
+
+    stateHash = m_checkpoints[m_nextCheckpoint++].stateHash;
+    return true;
+}
+
+bool InputPlayer::readVarint(std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (m_cursor >= m_data.size()) return false;
+        std::uint8_t byte = m_data[m_cursor++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool InputPlayer::readSigned(std::int64_t& value) {
+    std::uint64_t raw = 0;
+    if (!readVarint(raw)) return false;
+    value = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+    return true;
+}
+
+bool InputPlayer::readEvent(sf::Event& event) {
+    if (m_cursor >= m_data.size()) return false;
+    event.type = static_cast<sf::Event::EventType>(m_data[m_cursor++]);
+
+    std::uint64_t a = 0, b = 0;
+    std::int64_t x = 0, y = 0;
+
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            if (!readSigned(x) || m_cursor >= m_data.size()) return false;
+            std::uint8_t mods = m_data[m_cursor++];
+            event.key.code = static_cast<sf::Keyboard::Key>(x);
+            event.key.alt = (mods & ModAlt) != 0;
+            event.key.control = (mods & ModControl) != 0;
+            event.key.shift = (mods & ModShift) != 0;
+            event.key.system = (mods & ModSystem) != 0;
+            return true;
+        }
+
+        case sf::Event::TextEntered:
+            if (!readVarint(a)) return false;
+            event.text.unicode = static_cast<sf::Uint32>(a);
+            return true;
+
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            if (!readVarint(a) || !readSigned(x) || !readSigned(y)) return false;
+            event.mouseButton.button = static_cast<sf::Mouse::Button>(a);
+            event.mouseButton.x = static_cast<int>(x);
+            event.mouseButton.y = static_cast<int>(y);
+            return true;
+
+        case sf::Event::MouseMoved:
+            if (!readSigned(x) || !readSigned(y)) return false;
+            event.mouseMove.x = static_cast<int>(x);
+            event.mouseMove.y = static_cast<int>(y);
+            return true;
+
+        case sf::Event::MouseWheelScrolled: {
+            if (!readVarint(a) || !readVarint(b) || !readSigned(x) || !readSigned(y)) return false;
+            std::uint32_t bits = static_cast<std::uint32_t>(b);
+            event.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(a);
+            std::memcpy(&event.mouseWheelScroll.delta, &bits, sizeof(bits));
+            event.mouseWheelScroll.x = static_cast<int>(x);
+            event.mouseWheelScroll.y = static_cast<int>(y);
+            return true;
+        }
+
+        case sf::Event::Resized:
+            if (!readVarint(a) || !readVarint(b)) return false;
+            event.size.width = static_cast<unsigned int>(a);
+            event.size.height = static_cast<unsigned int>(b);
+            return true;
+
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,232 @@
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include <algorithm>
+
+namespace {
+    // Which pool (if any) the current thread works for, and its queue index
+    thread_local const JobSystem* t_owner = nullptr;
+    thread_local std::size_t t_workerIndex = 0;
+}
+
+bool JobSystem::JobHandle::isDone() const {
+    return !m_node || m_node->done.load(std::memory_order_acquire);
+}
+
+JobSystem::JobSystem(std::size_t workerCount)
+    : m_nextQueue(0)
+    , m_queued(0)
+    , m_stopping(false)
+{
+    if (workerCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    // Workers drain their queues before leaving
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+JobSystem::JobHandle JobSystem::schedule(Task task, const std::vector<JobHandle>& dependencies) {
+    auto job = std::make_shared<JobNode>();
+    job->task = std::move(task);
+
+    for (const JobHandle& dependency : dependencies) {
+        if (!dependency.m_node) continue;
+
+        std::lock_guard<std::mutex> lock(dependency.m_node->mutex);
+        if (!dependency.m_node->finished) {
+            dependency.m_node->dependents.push_back(job);
+            job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Drop the scheduling reference; whoever reaches zero queues the job
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        enqueue(job);
+    }
+    return JobHandle(job);
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (!job.isDone()) {
+        if (!tryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::wait(const std::vector<JobHandle>& jobs) {
+    for (const JobHandle& job : jobs) {
+        wait(job);
+    }
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& body) {
+    if (count == 0) return;
+
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    // The chunks only reference this frame, which outlives them because we
+    // wait below
+    std::atomic<std::size_t> remaining(chunks - 1);
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+        std::size_t begin = chunk * grain;
+        std::size_t end = std::min(begin + grain, count);
+        schedule([&body, &remaining, begin, end]() {
+            body(begin, end);
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    body(0, std::min(grain, count));
+
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::postToMainThread(Task task) {
+    std::lock_guard<std::mutex> lock(m_mainMutex);
+    m_mainQueue.push_back(std::move(task));
+}
+
+std::size_t JobSystem::pumpMainThread() {
+    std::vector<Task> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        ready.swap(m_mainQueue);
+    }
+
+    // Continuations may post more work; that runs on the next pump
+    for (Task& task : ready) {
+        task();
+    }
+    return ready.size();
+}
+
+void JobSystem::workerLoop(std::size_t index) {
+    t_owner = this;
+    t_workerIndex = index;
+
+    while (true) {
+        if (auto job = takeJob(index)) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this]() {
+            return m_stopping || m_queued.load(std::memory_order_acquire) > 0;
+        });
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void JobSystem::enqueue(std::shared_ptr<JobNode> job) {
+    // Workers keep follow-up work local; other threads spread it out
+    std::size_t index = currentWorkerIndex();
+    if (index == m_queues.size()) {
+        index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(std::move(job));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the wake lock orders this against a worker checking m_queued
+    { std::lock_guard<std::mutex> lock(m_wakeMutex); }
+    m_wakeCondition.notify_one();
+}
+
+std::shared_ptr<JobSystem::JobNode> JobSystem::takeJob(std::size_t preferredQueue) {
+    std::size_t queueCount = m_queues.size();
+
+    // Own queue: newest first, it is the most likely to be in cache
+    if (preferredQueue < queueCount) {
+        WorkerQueue& own = *m_queues[preferredQueue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            auto job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // Steal the oldest job from the next non-empty victim
+    std::size_t start = preferredQueue < queueCount ? preferredQueue + 1 : 0;
+    for (std::size_t i = 0; i < queueCount; ++i) {
+        WorkerQueue& victim = *m_queues[(start + i) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            auto job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::tryRunOne() {
+    if (auto job = takeJob(currentWorkerIndex())) {
+        execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(const std::shared_ptr<JobNode>& job) {
+    {
+        PROFILE_SCOPE("Job");
+        job->task();
+    }
+    job->task = nullptr;
+
+    std::vector<std::shared_ptr<JobNode>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished = true;
+        dependents.swap(job->dependents);
+    }
+    job->done.store(true, std::memory_order_release);
+
+    for (auto& dependent : dependents) {
+        if (dependent->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            enqueue(std::move(dependent));
+        }
+    }
+}
+
+std::size_t JobSystem::currentWorkerIndex() const {
+    return t_owner == this ? t_workerIndex : m_queues.size();
+}
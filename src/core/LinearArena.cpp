@@ -0,0 +1,113 @@
+#include "core/LinearArena.h"
+#include "Constants.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace {
+    constexpr std::size_t BlockAlignment = alignof(std::max_align_t);
+    constexpr std::size_t MinChunkSize = 4096;
+
+    // Aligned bump inside [base, base + size); null when it does not fit
+    void* bump(std::byte* base, std::size_t size, std::size_t& used, std::size_t bytes, std::size_t alignment) {
+        void* ptr = base + used;
+        std::size_t space = size - used;
+        if (!std::align(alignment, bytes, ptr, space)) return nullptr;
+        used = static_cast<std::size_t>(static_cast<std::byte*>(ptr) - base) + bytes;
+        return ptr;
+    }
+}
+
+LinearArena::LinearArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream)
+    , m_buffer(capacity > 0 ? static_cast<std::byte*>(upstream->allocate(capacity, BlockAlignment)) : nullptr)
+    , m_capacity(capacity)
+    , m_used(0)
+    , m_ownsBuffer(true)
+    , m_chunks(nullptr)
+    , m_chunkUsed(0)
+    , m_overflowBytes(0)
+    , m_highWater(0)
+    , m_overflowCount(0)
+{
+}
+
+LinearArena::LinearArena(void* buffer, std::size_t size, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream)
+    , m_buffer(static_cast<std::byte*>(buffer))
+    , m_capacity(size)
+    , m_used(0)
+    , m_ownsBuffer(false)
+    , m_chunks(nullptr)
+    , m_chunkUsed(0)
+    , m_overflowBytes(0)
+    , m_highWater(0)
+    , m_overflowCount(0)
+{
+}
+
+LinearArena::~LinearArena() {
+    releaseChunks();
+    if (m_ownsBuffer && m_buffer) {
+        m_upstream->deallocate(m_buffer, m_capacity, BlockAlignment);
+    }
+}
+
+void LinearArena::reset() {
+    if (m_chunks) {
+        releaseChunks();
+
+        if (m_ownsBuffer) {
+            // One block big enough for the busiest frame so far, with slack for
+            // alignment padding that lands differently in a single block
+            std::size_t capacity = (m_highWater + m_highWater / 4 + MinChunkSize - 1) / MinChunkSize * MinChunkSize;
+            if (m_buffer) {
+                m_upstream->deallocate(m_buffer, m_capacity, BlockAlignment);
+            }
+            m_buffer = static_cast<std::byte*>(m_upstream->allocate(capacity, BlockAlignment));
+            m_capacity = capacity;
+        }
+    }
+
+    m_used = 0;
+    m_overflowBytes = 0;
+}
+
+LinearArena& LinearArena::frame() {
+    static thread_local LinearArena arena(Constants::FRAME_ARENA_SIZE);
+    return arena;
+}
+
+void* LinearArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* ptr = m_buffer ? bump(m_buffer, m_capacity, m_used, bytes, alignment) : nullptr;
+
+    if (!ptr && m_chunks) {
+        std::size_t before = m_chunkUsed;
+        ptr = bump(reinterpret_cast<std::byte*>(m_chunks + 1), m_chunks->size, m_chunkUsed, bytes, alignment);
+        m_overflowBytes += m_chunkUsed - before;
+    }
+
+    if (!ptr) {
+        // Out of room: borrow a chunk large enough for this request at any alignment
+        std::size_t size = std::max({bytes + alignment, m_capacity, MinChunkSize});
+        void* raw = m_upstream->allocate(sizeof(Chunk) + size, BlockAlignment);
+        m_chunks = ::new (raw) Chunk{m_chunks, size};
+        m_chunkUsed = 0;
+        ++m_overflowCount;
+
+        ptr = bump(reinterpret_cast<std::byte*>(m_chunks + 1), size, m_chunkUsed, bytes, alignment);
+        m_overflowBytes += m_chunkUsed;
+    }
+
+    m_highWater = std::max(m_highWater, getUsed());
+    return ptr;
+}
+
+void LinearArena::releaseChunks() {
+    while (m_chunks) {
+        Chunk* next = m_chunks->next;
+        m_upstream->deallocate(m_chunks, sizeof(Chunk) + m_chunks->size, BlockAlignment);
+        m_chunks = next;
+    }
+    m_chunkUsed = 0;
+}
@@ -0,0 +1,124 @@
+#include "core/Profiler.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    std::int64_t steadyMicroseconds() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void writeEscaped(std::ostream& out, const char* text) {
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+    }
+}
+
+Profiler::Zone::Zone(const char* name)
+    : m_name(name)
+    , m_start(Profiler::instance().nowMicroseconds())
+{
+}
+
+Profiler::Zone::~Zone() {
+    Profiler& profiler = Profiler::instance();
+    profiler.record(m_name, m_start, profiler.nowMicroseconds());
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : m_epoch(steadyMicroseconds())
+{
+}
+
+std::int64_t Profiler::nowMicroseconds() const {
+    return steadyMicroseconds() - m_epoch;
+}
+
+Profiler::ThreadBuffer& Profiler::localBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->blocks.push_back(std::make_unique<Block>());
+        created->head = created->tail = created->blocks.back().get();
+
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        created->threadIndex = static_cast<std::uint32_t>(m_threads.size());
+        buffer = created.get();
+        m_threads.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+void Profiler::record(const char* name, std::int64_t startUs, std::int64_t endUs) {
+    ThreadBuffer& buffer = localBuffer();
+    Block* block = buffer.tail;
+    std::size_t index = block->count.load(std::memory_order_relaxed);
+
+    if (index == BlockSize) {
+        if (buffer.blocks.size() >= MaxBlocksPerThread) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.blocks.push_back(std::make_unique<Block>());
+        Block* fresh = buffer.blocks.back().get();
+        block->next.store(fresh, std::memory_order_release);
+        buffer.tail = block = fresh;
+        index = 0;
+    }
+
+    block->events[index] = Event{name, startUs, endUs - startUs};
+    block->count.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::exportChromeTrace(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "Failed to write trace: " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::size_t total = 0;
+
+    for (const auto& thread : m_threads) {
+        // Thread name metadata so the viewer labels the tracks
+        std::string threadName = thread->threadIndex == 0 ? "Main" : "Worker " + std::to_string(thread->threadIndex);
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread->threadIndex << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+        first = false;
+
+        // Walk the chain through the published links, not the writer-owned vector
+        for (const Block* block = thread->head; block; block = block->next.load(std::memory_order_acquire)) {
+            std::size_t count = block->count.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i) {
+                const Event& event = block->events[i];
+                out << ",\n{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->threadIndex
+                    << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << "}";
+            }
+            total += count;
+        }
+
+        std::size_t dropped = thread->dropped.load(std::memory_order_relaxed);
+        if (dropped > 0) {
+            std::cerr << "Profiler: thread " << thread->threadIndex << " dropped " << dropped << " events" << std::endl;
+        }
+    }
+
+    out << "\n]}\n";
+    std::cout << "Profiler: wrote " << total << " events to " << filename << std::endl;
+    return true;
+}
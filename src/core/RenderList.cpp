@@ -0,0 +1,63 @@
+#include "core/RenderList.h"
+#include "Constants.h"
+
+RenderList::RenderList()
+    : m_target(nullptr)
+    , m_size(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT)
+    , m_defaultView(sf::FloatRect(0.f, 0.f, Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT))
+    , m_interpolation(0.f)
+{
+}
+
+RenderList::RenderList(sf::RenderTarget& target)
+    : m_target(&target)
+    , m_size(target.getSize())
+    , m_defaultView(target.getDefaultView())
+    , m_interpolation(0.f)
+{
+}
+
+void RenderList::reset(const sf::Vector2u& size) {
+    m_commands.clear();
+    m_views.clear();
+    if (size != m_size) {
+        m_size = size;
+        m_defaultView.reset(sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y)));
+    }
+}
+
+void RenderList::draw(std::shared_ptr<const sf::Drawable> drawable, const sf::RenderStates& states) {
+    if (m_target) {
+        m_target->draw(*drawable, states);
+        return;
+    }
+    m_commands.push_back(Command{std::move(drawable), states, 0});
+}
+
+void RenderList::setView(const sf::View& view) {
+    if (m_target) {
+        m_target->setView(view);
+        return;
+    }
+    m_views.push_back(view);
+    m_commands.push_back(Command{nullptr, sf::RenderStates::Default, m_views.size() - 1});
+}
+
+const sf::View& RenderList::getDefaultView() const {
+    return m_target ? m_target->getDefaultView() : m_defaultView;
+}
+
+sf::Vector2u RenderList::getSize() const {
+    return m_target ? m_target->getSize() : m_size;
+}
+
+void RenderList::replay(sf::RenderTarget& target) const {
+    for (const Command& command : m_commands) {
+        if (command.drawable) {
+            target.draw(*command.drawable, command.states);
+        } else {
+            target.setView(m_views[command.view]);
+        }
+    }
+    target.setView(target.getDefaultView());
+}
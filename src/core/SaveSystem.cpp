@@ -1,4 +1,5 @@
 #include "core/SaveSystem.h"
+#include "core/Profiler.h"
 #include "Constants.h"
 #include <fstream>
 #include <iostream>
@@ -12,6 +13,7 @@ SaveSystem::~SaveSystem() {
 }
 
 bool SaveSystem::saveGame(const SaveData& data, const std::string& filename) {
+    PROFILE_SCOPE("SaveSystem::saveGame");
     std::string path = getFullPath(filename.empty() ? m_defaultSaveFile : filename);
     
     try {
@@ -35,6 +37,7 @@ bool SaveSystem::saveGame(const SaveData& data, const std::string& filename) {
 }
 
 bool SaveSystem::loadGame(SaveData& data, const std::string& filename) {
+    PROFILE_SCOPE("SaveSystem::loadGame");
     std::string path = getFullPath(filename.empty() ? m_defaultSaveFile : filename);
     
     try {
@@ -0,0 +1,191 @@
+#include "core/SoundBank.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    constexpr std::size_t DefaultCacheCapacity = 4;
+}
+
+SoundBank::SoundBank()
+    : m_cacheCapacity(DefaultCacheCapacity)
+    , m_useCounter(0)
+{
+}
+
+bool SoundBank::loadManifest(const std::vector<std::string>& filenames, Storage storage, JobSystem& jobs) {
+    PROFILE_SCOPE("SoundBank::loadManifest");
+    std::vector<DecodeJob> decodes;
+    for (const std::string& filename : filenames) {
+        if (m_handles.find(filename) != m_handles.end()) {
+            continue; // Already in the bank
+        }
+        DecodeJob job;
+        job.filename = filename;
+        decodes.push_back(std::move(job));
+    }
+
+    if (decodes.empty()) return true;
+
+    // Decoding only touches the file and plain sample vectors, so it is safe off the main thread
+    jobs.parallelFor(decodes.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            decodeFile(decodes[i], storage);
+        }
+    });
+
+    // sf::SoundBuffer creation talks to OpenAL, keep it on the main thread
+    bool allLoaded = true;
+    for (DecodeJob& job : decodes) {
+        if (!job.ok) {
+            std::cerr << "Failed to load sound: " << job.filename << std::endl;
+            allLoaded = false;
+            continue;
+        }
+
+        m_entries.emplace_back();
+        Entry& entry = m_entries.back();
+        entry.filename = job.filename;
+        entry.storage = storage;
+
+        if (storage == Storage::Decoded) {
+            entry.decoded = entry.buffer.loadFromSamples(job.samples.data(), job.samples.size(),
+                                                         job.channelCount, job.sampleRate);
+        } else {
+            entry.encoded = std::move(job.encoded);
+        }
+
+        m_handles[entry.filename] = m_entries.size() - 1;
+    }
+
+#ifdef DEBUG
+    std::cout << "Sound bank: " << m_entries.size() << " effects, "
+              << getDecodedBytes() / 1024 << " KiB decoded, "
+              << getCompressedBytes() / 1024 << " KiB compressed" << std::endl;
+#endif
+
+    return allLoaded;
+}
+
+SoundBank::Handle SoundBank::load(const std::string& filename) {
+    auto found = m_handles.find(filename);
+    if (found != m_handles.end()) {
+        return found->second;
+    }
+
+    sf::SoundBuffer buffer;
+    if (!buffer.loadFromFile(filename)) {
+        std::cerr << "Failed to load sound: " << filename << std::endl;
+        return InvalidHandle;
+    }
+
+#ifdef DEBUG
+    std::cout << "Sound bank: " << filename << " was not in the manifest, decoded on demand" << std::endl;
+#endif
+
+    m_entries.emplace_back();
+    Entry& entry = m_entries.back();
+    entry.filename = filename;
+    entry.buffer = buffer;
+    entry.decoded = true;
+
+    Handle handle = m_entries.size() - 1;
+    m_handles[filename] = handle;
+    return handle;
+}
+
+const sf::SoundBuffer* SoundBank::acquire(Handle handle) {
+    if (handle >= m_entries.size()) return nullptr;
+
+    Entry& entry = m_entries[handle];
+    entry.lastUsed = ++m_useCounter;
+
+    if (!entry.decoded) {
+        evictFor(entry);
+        if (!decodeEntry(entry)) {
+            return nullptr;
+        }
+    }
+
+    return &entry.buffer;
+}
+
+void SoundBank::setCacheCapacity(std::size_t capacity) {
+    m_cacheCapacity = std::max<std::size_t>(1, capacity);
+}
+
+std::size_t SoundBank::getDecodedBytes() const {
+    std::size_t bytes = 0;
+    for (const Entry& entry : m_entries) {
+        if (entry.decoded) {
+            bytes += static_cast<std::size_t>(entry.buffer.getSampleCount()) * sizeof(sf::Int16);
+        }
+    }
+    return bytes;
+}
+
+std::size_t SoundBank::getCompressedBytes() const {
+    std::size_t bytes = 0;
+    for (const Entry& entry : m_entries) {
+        bytes += entry.encoded.size();
+    }
+    return bytes;
+}
+
+void SoundBank::decodeFile(DecodeJob& job, Storage storage) {
+    PROFILE_SCOPE("SoundBank::decodeFile");
+    if (storage == Storage::Compressed) {
+        std::ifstream file(job.filename, std::ios::binary);
+        if (!file) return;
+        job.encoded.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        job.ok = !job.encoded.empty();
+        return;
+    }
+
+    sf::InputSoundFile file;
+    if (!file.openFromFile(job.filename)) return;
+
+    job.samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+    job.channelCount = file.getChannelCount();
+    job.sampleRate = file.getSampleRate();
+    job.ok = file.read(job.samples.data(), job.samples.size()) == job.samples.size();
+}
+
+bool SoundBank::decodeEntry(Entry& entry) {
+    PROFILE_SCOPE("SoundBank::decodeEntry");
+    if (!entry.buffer.loadFromMemory(entry.encoded.data(), entry.encoded.size())) {
+        std::cerr << "Failed to decode sound: " << entry.filename << std::endl;
+        return false;
+    }
+
+    entry.decoded = true;
+    return true;
+}
+
+void SoundBank::evictFor(const Entry& incoming) {
+    // Only compressed entries take part in the cache; decoded ones are always resident
+    std::size_t cached = 0;
+    for (const Entry& entry : m_entries) {
+        if (entry.storage == Storage::Compressed && entry.decoded) ++cached;
+    }
+
+    while (cached >= m_cacheCapacity) {
+        Entry* victim = nullptr;
+        for (Entry& entry : m_entries) {
+            if (&entry == &incoming || entry.storage != Storage::Compressed || !entry.decoded) continue;
+            if (m_inUse && m_inUse(entry.buffer)) continue;
+            if (!victim || entry.lastUsed < victim->lastUsed) {
+                victim = &entry;
+            }
+        }
+
+        if (!victim) break; // Everything cached is playing, grow past capacity for now
+
+        victim->buffer = sf::SoundBuffer();
+        victim->decoded = false;
+        --cached;
+    }
+}
@@ -0,0 +1,19 @@
+#include "core/StatusSet.h"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<StatusSet>::value && sizeof(StatusSet) == 2 * StatusSet::Count + 1,
+              "StatusSet is copied with every combat state");
+
+// The active bits take the low byte and each type 16 bits above it: a fourth
+// type would shift past 64 bits. Widen the result before adding one
+static_assert(8 + 16 * StatusSet::Count <= 64, "pack() fits three effect types in 64 bits");
+
+std::uint64_t StatusSet::pack() const {
+    std::uint64_t packed = m_active;
+    for (std::size_t type = 0; type < Count; ++type) {
+        if (!has(static_cast<Type>(type))) continue;
+        packed |= static_cast<std::uint64_t>(m_durations[type]) << (8 + 16 * type)
+                | static_cast<std::uint64_t>(m_magnitudes[type]) << (16 + 16 * type);
+    }
+    return packed;
+}
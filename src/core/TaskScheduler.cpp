@@ -0,0 +1,106 @@
+#include "core/TaskScheduler.h"
+
+TaskScheduler::Task& TaskScheduler::Task::operator=(Task&& other) noexcept {
+    if (this != &other) {
+        if (m_handle) m_handle.destroy();
+        m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+}
+
+TaskScheduler::Task::~Task() {
+    if (m_handle) m_handle.destroy();
+}
+
+TaskScheduler::TaskScheduler()
+    : m_now(0)
+    , m_nextID(1)
+    , m_nextSequence(0)
+    , m_running(0)
+{
+}
+
+TaskScheduler::~TaskScheduler() {
+    cancelAll();
+}
+
+TaskScheduler::TaskID TaskScheduler::spawn(Task task) {
+    Handle handle = std::exchange(task.m_handle, nullptr);
+    if (!handle) return 0;
+
+    TaskID id = m_nextID++;
+    handle.promise().id = id;
+    m_tasks.emplace(id, handle);
+
+    resume(id);
+    return id;
+}
+
+void TaskScheduler::cancel(TaskID id) {
+    auto found = m_tasks.find(id);
+    if (found == m_tasks.end()) return;
+
+    // A running frame cannot be destroyed under itself; resume() does it
+    // once the task suspends
+    if (id == m_running) {
+        found->second.promise().cancelled = true;
+        return;
+    }
+
+    found->second.destroy();
+    m_tasks.erase(found);
+}
+
+void TaskScheduler::cancelAll() {
+    for (auto itr = m_tasks.begin(); itr != m_tasks.end(); ) {
+        if (itr->first == m_running) {
+            itr->second.promise().cancelled = true;
+            ++itr;
+        } else {
+            itr->second.destroy();
+            itr = m_tasks.erase(itr);
+        }
+    }
+
+    m_timers = decltype(m_timers)();
+    m_nextTick.clear();
+}
+
+void TaskScheduler::advance(sf::Time dt) {
+    m_now += dt.asMicroseconds();
+
+    // Taken first: tasks asking for the next tick during this advance wait for the next one
+    m_ticking.swap(m_nextTick);
+
+    while (!m_timers.empty() && m_timers.top().wakeTime <= m_now) {
+        TaskID id = m_timers.top().id;
+        m_timers.pop();
+        resume(id);
+    }
+
+    for (TaskID id : m_ticking) {
+        resume(id);
+    }
+    m_ticking.clear();
+}
+
+void TaskScheduler::sleep(TaskID id, sf::Time duration) {
+    m_timers.push(Timer{m_now + duration.asMicroseconds(), m_nextSequence++, id});
+}
+
+void TaskScheduler::resume(TaskID id) {
+    auto found = m_tasks.find(id);
+    if (found == m_tasks.end()) return;    // Cancelled while suspended
+    Handle handle = found->second;
+
+    // Tasks may spawn or resume others, so restore the outer one afterwards
+    TaskID outer = m_running;
+    m_running = id;
+    handle.resume();
+    m_running = outer;
+
+    if (handle.done() || handle.promise().cancelled) {
+        handle.destroy();
+        m_tasks.erase(id);
+    }
+}
@@ -0,0 +1,17 @@
+#include "core/TypeChart.h"
+
+// Both loops vectorize at -O3 (Release); indices are plain int because the
+// compilers only turn signed 32-bit indexed loads into gathers
+void TypeChart::effectiveness(const PokemonType* attackers, const PokemonType* defenders, float* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        int index = static_cast<int>(attackers[i]) * static_cast<int>(Count) + static_cast<int>(defenders[i]);
+        out[i] = Table[index];
+    }
+}
+
+void TypeChart::effectiveness(PokemonType attacker, const PokemonType* defenders, float* out, std::size_t count) {
+    int row = static_cast<int>(attacker) * static_cast<int>(Count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = Table[row + static_cast<int>(defenders[i])];
+    }
+}
@@ -20,8 +20,8 @@ CombatAction Bisasam::chooseAction(const Entity& target) const {
     
     if (rng.rollRange(1, 100) <= 70) {
         // Try to use special skill
-        for (const auto& skill : m_skills) {
-            if (skill->canUse(m_currentMP) && skill->getType() != SkillType::Tackle) {
+        for (SkillType skill : m_skills) {
+            if (canUseSkill(skill) && skill != SkillType::Tackle) {
                 return CombatAction::UseSkill;
             }
         }
@@ -33,9 +33,9 @@ CombatAction Bisasam::chooseAction(const Entity& target) const {
 SkillType Bisasam::selectRandomSpecialSkill() const {
     std::vector<SkillType> availableSkills;
     
-    for (const auto& skill : m_skills) {
-        if (skill->canUse(m_currentMP) && skill->getType() != SkillType::Tackle) {
-            availableSkills.push_back(skill->getType());
+    for (SkillType skill : m_skills) {
+        if (canUseSkill(skill) && skill != SkillType::Tackle) {
+            availableSkills.push_back(skill);
         }
     }
     
@@ -61,8 +61,8 @@ void Bisasam::setupSkills() {
     m_skills.clear();
     
     // Bisasam has 1 normal attack + 1 special skill
-    addSkill(Skill::createTackle());    // Normal attack
-    addSkill(Skill::createVineWhip());  // Special grass attack
+    addSkill(SkillType::Tackle);    // Normal attack
+    addSkill(SkillType::VineWhip);  // Special grass attack
 }
 
 void Bisasam::setupBisasam() {
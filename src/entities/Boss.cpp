@@ -1,7 +1,11 @@
 #include "entities/Boss.h"
 #include "Constants.h"
+#include <iostream>
 
-Boss::Boss() : Enemy("Boss", PokemonType::Fire) {
+Boss::Boss()
+    : Enemy("Boss", PokemonType::Fire)
+    , m_search(Constants::BOSS_SEARCH_PLAYER_SKILL)
+{
     setupBossStats();
     m_sprite.setFillColor(sf::Color::Magenta);
     m_sprite.setSize(sf::Vector2f(Constants::TILE_SIZE, Constants::TILE_SIZE));
@@ -17,8 +21,8 @@ CombatAction Boss::chooseAction(const Entity& target) const {
     
     if (targetHPPercent < 0.4f) {
         // Aggressive mode - use strongest available skill
-        for (const auto& skill : m_skills) {
-            if (skill->canUse(m_currentMP) && skill->getData().damageMultiplier > 1.0f) {
+        for (SkillType skill : m_skills) {
+            if (canUseSkill(skill) && Skills::get(skill).data.damageMultiplier > 1.0f) {
                 return CombatAction::UseSkill;
             }
         }
@@ -28,6 +32,20 @@ CombatAction Boss::chooseAction(const Entity& target) const {
     return Enemy::chooseAction(target);
 }
 
+CombatEngine::EnemyMove Boss::chooseMove(const CombatEngine::State& battle) {
+    CombatSearch::Limits limits;
+    limits.maxDepth = Constants::BOSS_SEARCH_DEPTH;
+    limits.maxNodes = Constants::BOSS_SEARCH_NODES;
+    CombatSearch::Result result = m_search.chooseEnemyMove(battle, limits);
+
+#ifdef DEBUG
+    std::cout << "Boss search: move " << static_cast<int>(result.move) << " depth " << result.depth
+              << " nodes " << result.nodes << " in " << result.elapsed.count() << " us"
+              << " (player " << result.playerWinChance << ")" << std::endl;
+#endif
+    return result.move;
+}
+
 int Boss::modifyIncomingDamage(int damage) const {
     // Resolute passive: reduce damage by 10%
     return static_cast<int>(damage * Constants::BOSS_DAMAGE_REDUCTION);
@@ -39,9 +57,9 @@ std::unique_ptr<Boss> Boss::createBoss() {
 
 void Boss::setupSkills() {
     // Boss has multiple skills
-    addSkill(Skill::createPowerStrike());
-    addSkill(Skill::createCleave());
-    addSkill(Skill::createGuard());
+    addSkill(SkillType::PowerStrike);
+    addSkill(SkillType::Cleave);
+    addSkill(SkillType::Guard);
 }
 
 void Boss::setupBossStats() {
@@ -23,8 +23,8 @@ Enemy::~Enemy() {
 CombatAction Enemy::chooseAction(const Entity& target) const {
     (void)target; // Unused in simple AI for now
     // Simple AI: use skill if available and has MP, otherwise normal attack
-    for (const auto& skill : m_skills) {
-        if (skill->canUse(m_currentMP)) {
+    for (SkillType skill : m_skills) {
+        if (canUseSkill(skill)) {
             return CombatAction::UseSkill;
         }
     }
@@ -35,9 +35,9 @@ void Enemy::performAction(CombatAction action, Entity& target) {
     switch (action) {
         case CombatAction::UseSkill:
             // Use first available skill
-            for (auto& skill : m_skills) {
-                if (skill->canUse(m_currentMP)) {
-                    useSkill(skill->getType(), target);
+            for (SkillType skill : m_skills) {
+                if (canUseSkill(skill)) {
+                    useSkill(skill, target);
                     break;
                 }
             }
@@ -50,18 +50,21 @@ void Enemy::performAction(CombatAction action, Entity& target) {
     }
 }
 
-void Enemy::addSkill(std::unique_ptr<Skill> skill) {
-    m_skills.push_back(std::move(skill));
+CombatEngine::EnemyMove Enemy::chooseMove(const CombatEngine::State& battle) {
+    // Same simple rule as chooseAction: the skill whenever the MP allows
+    CombatEngine engine(battle);
+    if (engine.canUseEnemyMove(CombatEngine::EnemyMove::PowerStrike)) {
+        return CombatEngine::EnemyMove::PowerStrike;
+    }
+    return CombatEngine::EnemyMove::Attack;
 }
 
-std::vector<Skill*> Enemy::getAvailableSkills() const {
-    std::vector<Skill*> available;
-    for (const auto& skill : m_skills) {
-        if (skill->canUse(m_currentMP)) {
-            available.push_back(skill.get());
-        }
-    }
-    return available;
+void Enemy::addSkill(SkillType skillType) {
+    m_skills.add(skillType);
+}
+
+bool Enemy::canUseSkill(SkillType skillType) const {
+    return m_skills.canUse(skillType, m_currentMP);
 }
 
 void Enemy::normalAttack(Entity& target) {
@@ -71,24 +74,20 @@ void Enemy::normalAttack(Entity& target) {
 }
 
 void Enemy::useSkill(SkillType skillType, Entity& target) {
-    for (auto& skill : m_skills) {
-        if (skill->getType() == skillType && skill->canUse(m_currentMP)) {
-            modifyMP(-skill->getData().mpCost);
-            skill->use();
-
-            if (skill->getData().isOffensive) {
-                int damage = skill->calculateDamage(m_stats.atk);
-                target.modifyHP(-damage);
-            }
-            break;
-        }
+    if (!m_skills.canUse(skillType, m_currentMP)) return;
+
+    const SkillData& data = Skills::get(skillType).data;
+    modifyMP(-data.mpCost);
+    m_skills.use(skillType);
+
+    if (data.isOffensive) {
+        int damage = Skills::calculateDamage(skillType, m_stats.atk);
+        target.modifyHP(-damage);
     }
 }
 
 void Enemy::updateCooldowns() {
-    for (auto& skill : m_skills) {
-        skill->updateCooldown();
-    }
+    m_skills.updateCooldowns();
 }
 
 std::unique_ptr<Enemy> Enemy::createRegularEnemy() {
@@ -108,5 +107,5 @@ void Enemy::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 
 void Enemy::setupSkills() {
     // Give enemy a basic skill
-    addSkill(Skill::createPowerStrike());
+    addSkill(SkillType::PowerStrike);
 }
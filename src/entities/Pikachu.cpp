@@ -3,7 +3,7 @@
 #include "Constants.h"
 #include <memory>
 
-Pikachu::Pikachu() : Pokemon(PokemonType::Fire) { // Pikachu as Electric type (using Fire slot)
+Pikachu::Pikachu() : Pokemon(PokemonType::Electric) {
     setupPikachuSkills();
 }
 
@@ -28,14 +28,14 @@ void Pikachu::setupBaseSkills() {
     
     // Add Pikachu's 6 special skills
     // Attack skills
-    m_skills.push_back(Skill::createThunderBolt());
-    m_skills.push_back(Skill::createQuickAttack());
-    m_skills.push_back(Skill::createIronTail());
+    addSkill(SkillType::ThunderBolt);
+    addSkill(SkillType::QuickAttack);
+    addSkill(SkillType::IronTail);
     
     // Defense skills
-    m_skills.push_back(Skill::createAgility());
-    m_skills.push_back(Skill::createDoubleTeam());
-    m_skills.push_back(Skill::createSubstitute());
+    addSkill(SkillType::Agility);
+    addSkill(SkillType::DoubleTeam);
+    addSkill(SkillType::Substitute);
 }
 
 void Pikachu::setupEvolutionSkill() {
@@ -13,59 +13,40 @@ Pokemon::Pokemon(PokemonType type, const std::string& name)
 Pokemon::~Pokemon() {
 }
 
-void Pokemon::addSkill(std::unique_ptr<Skill> skill) {
-    m_skills.push_back(std::move(skill));
-}
-
-std::vector<Skill*> Pokemon::getAvailableSkills() const {
-    std::vector<Skill*> available;
-    for (const auto& skill : m_skills) {
-        if (skill->canUse(m_currentMP)) {
-            available.push_back(skill.get());
-        }
-    }
-    return available;
+void Pokemon::addSkill(SkillType skillType) {
+    m_skills.add(skillType);
 }
 
 bool Pokemon::canUseSkill(SkillType skillType) const {
-    for (const auto& skill : m_skills) {
-        if (skill->getType() == skillType && skill->canUse(m_currentMP)) {
-            return true;
-        }
-    }
-    return false;
+    return m_skills.canUse(skillType, m_currentMP);
 }
 
-int Pokemon::calculateDamage(const Skill& skill, const Entity& target) const {
-    int baseDamage = skill.calculateDamage(m_stats.atk);
+int Pokemon::calculateDamage(SkillType skillType, const Entity& target) const {
+    int baseDamage = Skills::calculateDamage(skillType, m_stats.atk);
     float effectiveness = getTypeEffectiveness(m_type, target.getType());
     return static_cast<int>(baseDamage * effectiveness);
 }
 
-int Pokemon::calculateHealing(const Skill& skill) const {
-    return skill.calculateHealing(m_stats.atk);
+int Pokemon::calculateHealing(SkillType skillType) const {
+    return Skills::calculateHealing(skillType, m_stats.atk);
 }
 
 void Pokemon::useSkill(SkillType skillType, Entity& target) {
-    for (auto& skill : m_skills) {
-        if (skill->getType() == skillType && skill->canUse(m_currentMP)) {
-            modifyMP(-skill->getData().mpCost);
-            skill->use();
-            
-            if (skill->getData().isOffensive) {
-                int damage = calculateDamage(*skill, target);
-                target.modifyHP(-damage);
-            } else if (skill->getData().healMultiplier > 0) {
-                int healing = calculateHealing(*skill);
-                modifyHP(healing);
-            }
-            
-            if (skill->hasSpecialEffect()) {
-                skill->applySpecialEffect(*this, target);
-            }
-            break;
-        }
+    if (!m_skills.canUse(skillType, m_currentMP)) return;
+
+    const SkillData& data = Skills::get(skillType).data;
+    modifyMP(-data.mpCost);
+    m_skills.use(skillType);
+
+    if (data.isOffensive) {
+        int damage = calculateDamage(skillType, target);
+        target.modifyHP(-damage);
+    } else if (data.healMultiplier > 0) {
+        int healing = calculateHealing(skillType);
+        modifyHP(healing);
     }
+    // Special effects are described by Skills::get(skillType).effect and
+    // resolved by the combat code
 }
 
 void Pokemon::normalAttack(Entity& target) {
@@ -75,15 +56,11 @@ void Pokemon::normalAttack(Entity& target) {
 }
 
 void Pokemon::updateCooldowns() {
-    for (auto& skill : m_skills) {
-        skill->updateCooldown();
-    }
+    m_skills.updateCooldowns();
 }
 
 void Pokemon::resetCooldowns() {
-    for (auto& skill : m_skills) {
-        skill->resetCooldown();
-    }
+    m_skills.resetCooldowns();
 }
 
 void Pokemon::evolve() {
@@ -95,27 +72,7 @@ void Pokemon::evolve() {
 }
 
 float Pokemon::getTypeEffectiveness(PokemonType attackerType, PokemonType defenderType) const {
-    if (attackerType == PokemonType::Fire && defenderType == PokemonType::Grass) {
-        return Constants::TYPE_SUPER_EFFECTIVE;
-    }
-    if (attackerType == PokemonType::Water && defenderType == PokemonType::Fire) {
-        return Constants::TYPE_SUPER_EFFECTIVE;
-    }
-    if (attackerType == PokemonType::Grass && defenderType == PokemonType::Water) {
-        return Constants::TYPE_SUPER_EFFECTIVE;
-    }
-    
-    if (attackerType == PokemonType::Fire && defenderType == PokemonType::Water) {
-        return Constants::TYPE_NOT_VERY_EFFECTIVE;
-    }
-    if (attackerType == PokemonType::Water && defenderType == PokemonType::Grass) {
-        return Constants::TYPE_NOT_VERY_EFFECTIVE;
-    }
-    if (attackerType == PokemonType::Grass && defenderType == PokemonType::Fire) {
-        return Constants::TYPE_NOT_VERY_EFFECTIVE;
-    }
-    
-    return Constants::TYPE_NORMAL_EFFECTIVE;
+    return TypeChart::effectiveness(attackerType, defenderType);
 }
 
 std::unique_ptr<Pokemon> Pokemon::createBlazeling() {
@@ -152,12 +109,12 @@ Blazeling::Blazeling() : Pokemon(PokemonType::Fire, "Blazeling") {
 }
 
 void Blazeling::setupBaseSkills() {
-    addSkill(Skill::createPowerStrike());
-    addSkill(Skill::createHeal());
+    addSkill(SkillType::PowerStrike);
+    addSkill(SkillType::Heal);
 }
 
 void Blazeling::setupEvolutionSkill() {
-    addSkill(Skill::createFireball());
+    addSkill(SkillType::Fireball);
 }
 
 Stats Blazeling::getBaseStats() const {
@@ -178,12 +135,12 @@ Aquary::Aquary() : Pokemon(PokemonType::Water, "Aquary") {
 }
 
 void Aquary::setupBaseSkills() {
-    addSkill(Skill::createCleave());
-    addSkill(Skill::createGuard());
+    addSkill(SkillType::Cleave);
+    addSkill(SkillType::Guard);
 }
 
 void Aquary::setupEvolutionSkill() {
-    addSkill(Skill::createAquaPulse());
+    addSkill(SkillType::AquaPulse);
 }
 
 Stats Aquary::getBaseStats() const {
@@ -204,12 +161,12 @@ Verdil::Verdil() : Pokemon(PokemonType::Grass, "Verdil") {
 }
 
 void Verdil::setupBaseSkills() {
-    addSkill(Skill::createCounter());
-    addSkill(Skill::createHeal());
+    addSkill(SkillType::Counter);
+    addSkill(SkillType::Heal);
 }
 
 void Verdil::setupEvolutionSkill() {
-    addSkill(Skill::createLeafBlade());
+    addSkill(SkillType::LeafBlade);
 }
 
 Stats Verdil::getBaseStats() const {
@@ -1,154 +1,47 @@
 #include "entities/Skill.h"
-#include "entities/Entity.h"
-#include "Constants.h"
-#include <algorithm>
 
-Skill::Skill(SkillType type, const std::string& name, const SkillData& data)
-    : m_type(type)
-    , m_name(name)
-    , m_data(data)
-    , m_currentCooldown(0)
-{
-}
+static_assert(Skills::Count <= 32, "SkillSet keeps one bit per SkillType");
 
-Skill::~Skill() {
+SkillSet::SkillSet()
+    : m_order()
+    , m_cooldowns()
+    , m_known(0)
+    , m_count(0)
+{
 }
 
-bool Skill::canUse(int currentMP) const {
-    return currentMP >= m_data.mpCost && m_currentCooldown == 0;
-}
+bool SkillSet::add(SkillType type) {
+    if (has(type) || m_count == MaxSkills) return false;
 
-void Skill::use() {
-    m_currentCooldown = m_data.cooldown;
+    m_order[m_count++] = type;
+    m_known |= 1u << static_cast<unsigned>(type);
+    m_cooldowns[static_cast<std::size_t>(type)] = 0;
+    return true;
 }
 
-void Skill::updateCooldown() {
-    if (m_currentCooldown > 0) {
-        m_currentCooldown--;
-    }
+void SkillSet::clear() {
+    m_known = 0;
+    m_count = 0;
+    m_cooldowns.fill(0);
 }
 
-void Skill::resetCooldown() {
-    m_currentCooldown = 0;
+bool SkillSet::canUse(SkillType type, int currentMP) const {
+    return has(type) && getCooldown(type) == 0 && currentMP >= Skills::get(type).data.mpCost;
 }
 
-int Skill::calculateDamage(int attackerATK) const {
-    return static_cast<int>(attackerATK * m_data.damageMultiplier);
+void SkillSet::use(SkillType type) {
+    m_cooldowns[static_cast<std::size_t>(type)] = static_cast<std::uint8_t>(Skills::get(type).data.cooldown);
 }
 
-int Skill::calculateHealing(int attackerATK) const {
-    return static_cast<int>(attackerATK * m_data.healMultiplier);
-}
-
-void Skill::applySpecialEffect(Entity& user, Entity& target) const {
-    (void)user; (void)target; // TODO: implement special effects
-    // Implement special effects based on skill type
-    switch (m_type) {
-        case SkillType::Guard:
-            // Guard effect would be handled in combat system
-            break;
-        case SkillType::Counter:
-            // Counter effect would be handled in combat system
-            break;
-        case SkillType::Fireball:
-        case SkillType::AquaPulse:
-        case SkillType::LeafBlade:
-            // 20% chance to apply debuff (simplified)
-            break;
-        default:
-            break;
+void SkillSet::updateCooldowns() {
+    for (SkillType type : *this) {
+        std::uint8_t& cooldown = m_cooldowns[static_cast<std::size_t>(type)];
+        if (cooldown > 0) {
+            cooldown--;
+        }
     }
 }
 
-std::unique_ptr<Skill> Skill::createPowerStrike() {
-    SkillData data(SkillType::PowerStrike, 8, 1, 1.6f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::PowerStrike, "Power Strike", data);
-}
-
-std::unique_ptr<Skill> Skill::createCleave() {
-    SkillData data(SkillType::Cleave, 12, 2, 1.2f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::Cleave, "Cleave", data);
-}
-
-std::unique_ptr<Skill> Skill::createHeal() {
-    SkillData data(SkillType::Heal, 10, 2, 0.0f, 0.8f, false, false, false);
-    return std::make_unique<Skill>(SkillType::Heal, "Heal", data);
-}
-
-std::unique_ptr<Skill> Skill::createGuard() {
-    SkillData data(SkillType::Guard, 6, 2, 0.0f, 0.0f, false, true, true);
-    return std::make_unique<Skill>(SkillType::Guard, "Guard", data);
-}
-
-std::unique_ptr<Skill> Skill::createCounter() {
-    SkillData data(SkillType::Counter, 10, 3, 0.0f, 0.0f, false, true, true);
-    return std::make_unique<Skill>(SkillType::Counter, "Counter", data);
-}
-
-std::unique_ptr<Skill> Skill::createFireball() {
-    SkillData data(SkillType::Fireball, 12, 2, 1.4f, 0.0f, true, false, true);
-    return std::make_unique<Skill>(SkillType::Fireball, "Fireball", data);
-}
-
-std::unique_ptr<Skill> Skill::createAquaPulse() {
-    SkillData data(SkillType::AquaPulse, 12, 2, 1.4f, 0.0f, true, false, true);
-    return std::make_unique<Skill>(SkillType::AquaPulse, "Aqua Pulse", data);
-}
-
-std::unique_ptr<Skill> Skill::createLeafBlade() {
-    SkillData data(SkillType::LeafBlade, 12, 2, 1.4f, 0.0f, true, false, true);
-    return std::make_unique<Skill>(SkillType::LeafBlade, "Leaf Blade", data);
-}
-
-// Pikachu Attack Skills
-std::unique_ptr<Skill> Skill::createThunderBolt() {
-    SkillData data(SkillType::ThunderBolt, 15, 2, 1.8f, 0.0f, true, false, true);
-    return std::make_unique<Skill>(SkillType::ThunderBolt, "Thunder Bolt", data);
-}
-
-std::unique_ptr<Skill> Skill::createQuickAttack() {
-    SkillData data(SkillType::QuickAttack, 8, 1, 1.2f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::QuickAttack, "Quick Attack", data);
-}
-
-std::unique_ptr<Skill> Skill::createIronTail() {
-    SkillData data(SkillType::IronTail, 12, 3, 1.6f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::IronTail, "Iron Tail", data);
-}
-
-// Pikachu Defense Skills
-std::unique_ptr<Skill> Skill::createAgility() {
-    SkillData data(SkillType::Agility, 10, 2, 0.0f, 0.0f, false, true, true);
-    return std::make_unique<Skill>(SkillType::Agility, "Agility", data);
-}
-
-std::unique_ptr<Skill> Skill::createDoubleTeam() {
-    SkillData data(SkillType::DoubleTeam, 12, 3, 0.0f, 0.0f, false, true, true);
-    return std::make_unique<Skill>(SkillType::DoubleTeam, "Double Team", data);
-}
-
-std::unique_ptr<Skill> Skill::createSubstitute() {
-    SkillData data(SkillType::Substitute, 15, 4, 0.0f, 0.0f, false, true, true);
-    return std::make_unique<Skill>(SkillType::Substitute, "Substitute", data);
-}
-
-// Monster Skills
-std::unique_ptr<Skill> Skill::createEmber() {
-    SkillData data(SkillType::Ember, 10, 2, 1.4f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::Ember, "Ember", data);
-}
-
-std::unique_ptr<Skill> Skill::createVineWhip() {
-    SkillData data(SkillType::VineWhip, 8, 2, 1.3f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::VineWhip, "Vine Whip", data);
-}
-
-std::unique_ptr<Skill> Skill::createTackle() {
-    SkillData data(SkillType::Tackle, 5, 1, 1.0f, 0.0f, true, false, false);
-    return std::make_unique<Skill>(SkillType::Tackle, "Tackle", data);
-}
-
-std::unique_ptr<Skill> Skill::createDodge() {
-    SkillData data(SkillType::Dodge, 5, 1, 0.0f, 0.0f, false, true, true);
-    return std::make_unique<Skill>(SkillType::Dodge, "Dodge", data);
+void SkillSet::resetCooldowns() {
+    m_cooldowns.fill(0);
 }
@@ -1,11 +1,71 @@
 #include "Game.h"
 #include <iostream>
 #include <exception>
+#include <stdexcept>
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
+    const char* usage = " [--headless] [--threaded] [--time-scale X|max] [--no-idle] [--turns N] [--seed S] [--record FILE | --replay FILE]";
+
+    GameOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // std::stoul and std::stof throw on values that are not numbers
+        try {
+            if (arg == "--headless") {
+                options.headless = true;
+            }
+            else if (arg == "--turns" && i + 1 < argc) {
+                options.headlessTurns = std::stoul(argv[++i]);
+            }
+            else if (arg == "--seed" && i + 1 < argc) {
+                options.hasSeed = true;
+                options.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--threaded") {
+                options.threaded = true;
+            }
+            else if (arg == "--no-idle") {
+                options.idleWait = false;
+            }
+            else if (arg == "--time-scale" && i + 1 < argc) {
+                std::string scale = argv[++i];
+                options.timeScale = scale == "max" ? 0.0f : std::stof(scale);
+                if (options.timeScale < 0.0f) {
+                    std::cerr << "--time-scale must be positive, or 0/max for unbounded" << std::endl;
+                    return 1;
+                }
+            }
+            else if (arg == "--record" && i + 1 < argc) {
+                options.recordFile = argv[++i];
+            }
+            else if (arg == "--replay" && i + 1 < argc) {
+                options.replayFile = argv[++i];
+            }
+            else {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                std::cerr << "Usage: " << argv[0] << usage << std::endl;
+                return 1;
+            }
+        }
+        catch (const std::logic_error&) {
+            std::cerr << "Bad argument: " << arg << " " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] << usage << std::endl;
+            return 1;
+        }
+    }
+
+    // The autopilot restarts games on its own, which a replay cannot reproduce
+    if (!options.recordFile.empty() && (options.headless || !options.replayFile.empty())) {
+        std::cerr << "--record only applies to interactive sessions" << std::endl;
+        return 1;
+    }
+
+    int exitCode = 0;
     try {
-        Game game;
+        Game game(options);
         game.run();
+        exitCode = game.getExitCode();
     }
     catch (std::exception& e) {
         std::cerr << "Exception: " << e.what() << std::endl;
@@ -15,6 +75,6 @@ int main() {
         std::cerr << "Unknown exception occurred" << std::endl;
         return 1;
     }
-    
-    return 0;
+
+    return exitCode;
 }
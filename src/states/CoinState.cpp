@@ -1,4 +1,5 @@
 #include "states/CoinState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
@@ -16,26 +17,25 @@ CoinState::CoinState(StateStack& stack, Context context)
     , m_playerChoice(CoinChoice::Head)
     , m_coinResult(true)
     , m_playerWon(false)
+    , m_coinSound(context.audio->loadSound(Constants::SFX_COIN))
 {
     setupUI();
 }
 
-void CoinState::draw() {
-    sf::RenderWindow& window = *getContext().window;
-    
+void CoinState::draw(RenderList& target) {
     // Draw semi-transparent background
     sf::RectangleShape background(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     background.setFillColor(sf::Color(0, 0, 0, 128));
-    window.draw(background);
+    target.draw(background);
     
-    m_instructionLabel.draw(window);
-    m_coinLabel.draw(window);
+    m_instructionLabel.draw(target);
+    m_coinLabel.draw(target);
     
     if (m_phase == Phase::Selection) {
-        m_headButton.draw(window);
-        m_tailButton.draw(window);
+        m_headButton.draw(target);
+        m_tailButton.draw(target);
     } else if (m_phase == Phase::Result) {
-        m_resultLabel.draw(window);
+        m_resultLabel.draw(target);
     }
 }
 
@@ -159,7 +159,7 @@ void CoinState::startFlipAnimation() {
     m_instructionLabel.setText("Flipping coin...");
     
     // Play coin sound
-    getContext().audio->playSound(Constants::SFX_COIN);
+    getContext().audio->playSound(m_coinSound);
 }
 
 void CoinState::finishAnimation() {
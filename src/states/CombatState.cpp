@@ -1,83 +1,215 @@
 #include "states/CombatState.h"
+#include "core/RenderList.h"
+#include "core/Profiler.h"
 #include "StateStack.h"
 #include "entities/Enemy.h"
 #include "entities/Boss.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
+#include "core/AudioManager.h"
 #include "core/RNG.h"
 #include <iostream>
-
-// Static variable definitions
-CombatResult CombatState::s_lastCombatResult = CombatResult::None;
-bool CombatState::s_combatJustEnded = false;
 #include "ui/TextLabel.h"
 #include "ui/Button.h"
-#include "ui/Bar.h"
 #include "ui/Panel.h"
 #include <SFML/Graphics.hpp>
 
+namespace {
+    const char* const AttackSkillNames[] = {"Thunderbolt", "Electro Ball", "Volt Tackle"};
+    const char* const DefenseSkillNames[] = {"Quick Guard", "Agility", "Charge"};
+    const char* const DefenseSkillMessages[] = {
+        "Pikachu used Quick Guard! Damage reduced by 50%!",
+        "Pikachu used Agility! Attack dodged completely!",
+        "Pikachu used Charge! Damage reduced and ATK boosted!"
+    };
+    const char* const StatusNames[] = {"Stunned", "Buffed", "Guarding"};
+    static_assert(sizeof(StatusNames) / sizeof(StatusNames[0]) == StatusSet::Count);
+
+    // Every active effect, in type order
+    std::string statusText(const StatusSet& status) {
+        if (!status.any()) return "Normal";
+
+        std::string text;
+        for (std::size_t i = 0; i < StatusSet::Count; ++i) {
+            if (!status.has(static_cast<StatusSet::Type>(i))) continue;
+            if (!text.empty()) text += ", ";
+            text += StatusNames[i];
+        }
+        return text;
+    }
+
+    CombatEngine::Encounter encounterFor(MonsterType monster) {
+        switch (monster) {
+            case MonsterType::Bisasam: return CombatEngine::Encounter::Bisasam;
+            case MonsterType::Boss:    return CombatEngine::Encounter::Boss;
+            default:                   return CombatEngine::Encounter::Chalamander;
+        }
+    }
+
+    std::string hintMove(CombatEngine::Action action, bool defending) {
+        switch (action) {
+            case CombatEngine::Action::CallHead:
+            case CombatEngine::Action::CallTail:
+                // The coin is fair: either call is as good
+                return "call the coin";
+            case CombatEngine::Action::Attack:
+                return "Attack";
+            default: {
+                int index = static_cast<int>(action) - static_cast<int>(CombatEngine::Action::Skill1);
+                return defending ? DefenseSkillNames[index] : AttackSkillNames[index];
+            }
+        }
+    }
+
+    // The text an entry shows as: most entries are one line, a strike two and
+    // a coin landing none. Returns the number of lines written
+    std::size_t formatLogEntry(const CombatLogEntry& entry, std::array<std::string, 2>& lines) {
+        using Event = CombatEngine::Event;
+        const std::string amount = std::to_string(entry.damage);
+
+        switch (entry.kind) {
+            case CombatLogEntry::BattleStart:
+                lines[0] = "Combat begins!";
+                return 1;
+            case CombatLogEntry::Hint:
+                lines[0] = "Hint: " + hintMove(static_cast<CombatEngine::Action>(entry.hintAction),
+                                               entry.flags & CombatLogEntry::Defending)
+                         + " (" + std::to_string(entry.hintWinPercent) + "% to win)";
+                return 1;
+            case Event::CoinLanded:
+                return 0;
+            case Event::NormalAttack:
+                lines[0] = "Pikachu used Normal Attack for " + amount + " damage!";
+                return 1;
+            case Event::Strike:
+                lines[0] = entry.skill ? "Pikachu used Special Attack!" : "Pikachu used Normal Attack!";
+                lines[1] = "Enemy takes " + amount + " damage!";
+                return 2;
+            case Event::SkillAttack:
+                lines[0] = std::string("Pikachu used ") + AttackSkillNames[entry.skill] + " for " + amount + " damage!";
+                return 1;
+            case Event::Recoil:
+                lines[0] = "Pikachu takes " + amount + " recoil damage!";
+                return 1;
+            case Event::EnemyStunned:
+                lines[0] = "Enemy is stunned!";
+                return 1;
+            case Event::EnemyLostTurn:
+                lines[0] = "Enemy is stunned and loses turn!";
+                return 1;
+            case Event::EnemyTurn:
+                lines[0] = "Enemy's turn! Choose HEAD/TAIL for defense!";
+                return 1;
+            case Event::DefenseCallRight:
+                lines[0] = "Coin correct! Choose defense skill!";
+                return 1;
+            case Event::DefenseCallWrong:
+                lines[0] = "Coin wrong! Taking full damage!";
+                return 1;
+            case Event::EnemyDodged:
+                lines[0] = "Enemy dodged the attack!";
+                return 1;
+            case Event::EnemyPowerStrike:
+                lines[0] = "Enemy used Power Strike!";
+                return 1;
+            case Event::EnemyGuard:
+                lines[0] = "Enemy raises its guard! Damage to it is reduced!";
+                return 1;
+            case Event::EnemyAttack:
+                lines[0] = "Enemy attacks for " + amount + " damage!";
+                return 1;
+            case Event::DefenseSkill:
+                lines[0] = DefenseSkillMessages[entry.skill];
+                return 1;
+            case Event::PlayerDamaged:
+                lines[0] = "Pikachu takes " + amount + " damage!";
+                return 1;
+            case Event::Victory:
+                lines[0] = "Victory!";
+                return 1;
+            case Event::Defeat:
+                lines[0] = "Unfortunately...";
+                return 1;
+            default:
+                return 0;
+        }
+    }
+}
+
 CombatState::CombatState(StateStack& stack, Context context)
     : State(stack, context)
-    , m_player(nullptr)
     , m_isBoss(false)
     , m_phase(CombatPhase::ReadyBanner)
-    , m_skillSelectionVisible(false)
-    , m_waitingForInput(false)
+    , m_logLineCount(0)
+    , m_logRendered(0)
+    , m_logVisible(false)
+    , m_combatStartedSub(0)
+    , m_session(EventBus::AnySession)
+    , m_monster(MonsterType::Chalamander)
+    , m_monsterPos(0, 0)
     , m_enemyType("chalamander")
-    , m_bannerTimer(sf::Time::Zero)
     , m_bannerDuration(sf::seconds(3.0f))
     , m_playerChoice(CoinChoice::None)
-    , m_coinResult(CoinResult::None)
-    , m_coinTimer(sf::Time::Zero)
     , m_coinDuration(sf::seconds(3.0f))
-    , m_coinCorrect(false)
-    , m_playerHP(100), m_playerMaxHP(100), m_playerATK(15), m_playerDEF(10)
-    , m_enemyHP(80), m_enemyMaxHP(80), m_enemyATK(12), m_enemyDEF(8)
     , m_playerName("Pikachu"), m_enemyName("Enemy")
-    , m_resultTimer(sf::Time::Zero)
     , m_resultDuration(sf::seconds(1.5f))
     , m_combatResult(CombatResult::None)
-    , m_showingSkillMenu(false)
-    , m_isDefenseSkillMenu(false)
+    , m_phaseTask(0)
+    , m_hitSound(context.audio->loadSound(Constants::SFX_HIT))
 {
     setupUI();
+
+    m_combatStartedSub = context.events->subscribe(GameEvent::Type::CombatStarted,
+        [this](const GameEvent& event) { onCombatStarted(event); });
+}
+
+CombatState::~CombatState() {
+    getContext().events->unsubscribe(m_combatStartedSub);
+}
+
+void CombatState::onEnter() {
+    // The instance is pooled: UI was built once in the constructor,
+    // only the per-encounter data is reset here
+    resetCombat();
+    getContext().audio->playMusic(Constants::BGM_COMBAT);
 }
 
-void CombatState::draw() {
-    sf::RenderWindow& window = *getContext().window;
+void CombatState::draw(RenderList& target) {
+    PROFILE_SCOPE("CombatState::draw");
     AssetManager& assets = *getContext().assets;
 
     // Draw combat background
-    sf::Sprite background = assets.makeFullScreenBackground("bg_combat", window.getSize());
-    window.draw(background);
+    sf::Sprite background = assets.makeFullScreenBackground("bg_combat", target.getSize());
+    target.draw(background);
 
     // Draw sprites with proper positioning
-    drawCombatSprites(window, assets);
+    drawCombatSprites(target, assets);
     
     // Remove all old UI panels - only keep compact stat panels
     
     // Draw enhanced UI based on phase
+    const CombatEngine::State& battle = m_engine.getState();
     const sf::Font& font = assets.hasGameFont("arial") ? assets.getGameFont("arial") : assets.getDefaultFont();
-    sf::Vector2f windowSize(window.getSize());
+    sf::Vector2f windowSize(target.getSize());
 
     switch (m_phase) {
         case CombatPhase::ReadyBanner:
-            CombatUI::drawBanner(window, "Are you Ready!?", font, windowSize);
+            CombatUI::drawBanner(target, "Are you Ready!?", font, windowSize);
             break;
 
         case CombatPhase::PlayerCoinChoice:
-            CombatUI::drawCoinChoice(window, font, windowSize);
-            m_headButton.draw(window);
-            m_tailButton.draw(window);
+            CombatUI::drawCoinChoice(target, font, windowSize);
+            m_headButton.draw(target);
+            m_tailButton.draw(target);
             break;
 
         case CombatPhase::PlayerCoinFlip:
-            CombatUI::drawCoinFlipping(window, font, windowSize);
+            CombatUI::drawCoinFlipping(target, font, windowSize);
             break;
 
         case CombatPhase::PlayerAction:
-            CombatUI::drawCoinResult(window, font, windowSize,
-                                   m_coinResult == CoinResult::Head, m_coinCorrect);
+            CombatUI::drawCoinResult(target, font, windowSize,
+                                   battle.coinHead, battle.coinCorrect);
             // Show attack prompt
             {
                 sf::Text attackText;
@@ -87,16 +219,16 @@ void CombatState::draw() {
                 attackText.setFillColor(sf::Color::Yellow);
                 sf::FloatRect bounds = attackText.getLocalBounds();
                 attackText.setPosition((windowSize.x - bounds.width) / 2.0f, windowSize.y - 100);
-                window.draw(attackText);
+                target.draw(attackText);
             }
             break;
 
         case CombatPhase::Victory:
-            CombatUI::drawBanner(window, "Victory!", font, windowSize, sf::Color::Green);
+            CombatUI::drawBanner(target, "Victory!", font, windowSize, sf::Color::Green);
             break;
 
         case CombatPhase::Defeat:
-            CombatUI::drawBanner(window, "Unfortunately...", font, windowSize, sf::Color::Red);
+            CombatUI::drawBanner(target, "Unfortunately...", font, windowSize, sf::Color::Red);
             break;
 
         default:
@@ -104,107 +236,58 @@ void CombatState::draw() {
     }
 
     // Draw skill menu if active
-    if (m_showingSkillMenu) {
+    if (battle.skillMenu) {
         // Draw semi-transparent background
         sf::RectangleShape overlay;
         overlay.setSize(sf::Vector2f(windowSize.x, windowSize.y));
         overlay.setFillColor(sf::Color(0, 0, 0, 128));
-        window.draw(overlay);
+        target.draw(overlay);
 
         // Draw skill menu title
         sf::Text menuTitle;
         menuTitle.setFont(font);
-        menuTitle.setString(m_isDefenseSkillMenu ? "Choose Defense Skill:" : "Choose Attack Skill:");
+        menuTitle.setString(battle.defending ? "Choose Defense Skill:" : "Choose Attack Skill:");
         menuTitle.setCharacterSize(28);
         menuTitle.setFillColor(sf::Color::White);
         sf::FloatRect titleBounds = menuTitle.getLocalBounds();
         menuTitle.setPosition((windowSize.x - titleBounds.width) / 2.0f, windowSize.y / 2.0f - 50);
-        window.draw(menuTitle);
+        target.draw(menuTitle);
 
         // Draw skill buttons
-        if (m_isDefenseSkillMenu) {
+        if (battle.defending) {
             for (auto& button : m_defenseSkillButtons) {
-                button.draw(window);
+                button.draw(target);
             }
         } else {
             for (auto& button : m_attackSkillButtons) {
-                button.draw(window);
+                button.draw(target);
             }
         }
     }
 
     // Draw stat panels with fixed positioning
-    std::string playerStatusText = (m_playerStatus.type == StatusEffect::Stun) ? "Stunned" :
-                                  (m_playerStatus.type == StatusEffect::ATKBonus) ? "Buffed" : "Normal";
-    std::string enemyStatusText = (m_enemyStatus.type == StatusEffect::Stun) ? "Stunned" : "Normal";
-
-    CombatUI::StatData playerStats(m_playerName, m_playerHP, m_playerMaxHP, m_playerATK, m_playerDEF, playerStatusText);
-    CombatUI::StatData enemyStats(m_enemyName, m_enemyHP, m_enemyMaxHP, m_enemyATK, m_enemyDEF, enemyStatusText);
-    CombatUI::drawStatPanelTopLeft(window, playerStats, font);
-    CombatUI::drawStatPanelBottomRight(window, enemyStats, font, windowSize);
+    const CombatEngine::Fighter& player = battle.player;
+    const CombatEngine::Fighter& enemy = battle.enemy;
+    CombatUI::StatData playerStats(m_playerName, player.hp, player.maxHp, player.atk, player.def, statusText(player.status));
+    CombatUI::StatData enemyStats(m_enemyName, enemy.hp, enemy.maxHp, enemy.atk, enemy.def, statusText(enemy.status));
+    CombatUI::drawStatPanelTopLeft(target, playerStats, font);
+    CombatUI::drawStatPanelBottomRight(target, enemyStats, font, windowSize);
+
+    if (m_logVisible) {
+        if (m_logRendered != m_log.getTotal()) {
+            refreshLogLabels();
+        }
+        m_logPanel.draw(target);
+        for (std::size_t i = 0; i < m_logLineCount; ++i) {
+            m_logMessages[i].draw(target);
+        }
+    }
 }
 
 bool CombatState::update(sf::Time dt) {
-    // Update phase timers
-    switch (m_phase) {
-        case CombatPhase::ReadyBanner:
-            m_bannerTimer += dt;
-            if (m_bannerTimer >= m_bannerDuration) {
-                m_phase = CombatPhase::PlayerCoinChoice;
-                m_bannerTimer = sf::Time::Zero;
-            }
-            break;
-
-        case CombatPhase::PlayerCoinFlip:
-            m_coinTimer += dt;
-            if (m_coinTimer >= m_coinDuration) {
-                // Generate coin result
-                m_coinResult = (getContext().rng->rollRange(1, 2) == 1) ? CoinResult::Head : CoinResult::Tail;
-                m_coinCorrect = (m_playerChoice == CoinChoice::Head && m_coinResult == CoinResult::Head) ||
-                               (m_playerChoice == CoinChoice::Tail && m_coinResult == CoinResult::Tail);
-
-                // Determine if this is attack or defense coin
-                if (m_isDefenseSkillMenu) {
-                    // This is defense coin for enemy turn
-                    resolveEnemyCoin(m_coinCorrect);
-                } else {
-                    // This is attack coin for player turn
-                    resolvePlayerCoin(m_coinCorrect);
-                }
-
-                m_phase = CombatPhase::PlayerAction;
-                m_coinTimer = sf::Time::Zero;
-            }
-            break;
-
-        case CombatPhase::Victory:
-        case CombatPhase::Defeat:
-            m_resultTimer += dt;
-            if (m_resultTimer >= m_resultDuration) {
-                // Determine result based on current phase
-                CombatResult result = CombatResult::None;
-                if (m_phase == CombatPhase::Victory) {
-                    result = CombatResult::Victory;
-                } else if (m_phase == CombatPhase::Defeat) {
-                    result = CombatResult::Unfortunately;
-                }
-
-                m_phase = CombatPhase::Ended;
-                m_combatResult = result;
-
-                // Set static result for MapState to read
-                s_lastCombatResult = result;
-                s_combatJustEnded = true;
-
-                std::cout << "CombatState: Setting result to " << (result == CombatResult::Victory ? "Victory" : "Unfortunately") << std::endl;
-
-                requestStackPop();
-            }
-            break;
-
-        default:
-            break;
-    }
+    PROFILE_SCOPE("CombatState::update");
+    // Resume phase tasks whose wait is over
+    m_tasks.advance(dt);
 
     // Update shake animations
     m_atkShakePika.update(dt);
@@ -212,13 +295,6 @@ bool CombatState::update(sf::Time dt) {
     m_hurtNudgePika.update(dt);
     m_hurtNudgeEnemy.update(dt);
 
-    // Update status effects
-    updateStatusEffects();
-
-    // Remove old UI updates - only keep essential elements
-    
-    updateUI();
-    
     return false;
 }
 
@@ -226,34 +302,38 @@ bool CombatState::handleEvent(const sf::Event& event) {
     // Handle coin choice
     if (m_phase == CombatPhase::PlayerCoinChoice && event.type == sf::Event::MouseButtonPressed) {
         if (m_headButton.handleEvent(event)) {
-            m_playerChoice = CoinChoice::Head;
-            m_phase = CombatPhase::PlayerCoinFlip;
-            m_coinTimer = sf::Time::Zero;
+            startCoinFlip(true);
             return true;
         }
         if (m_tailButton.handleEvent(event)) {
-            m_playerChoice = CoinChoice::Tail;
-            m_phase = CombatPhase::PlayerCoinFlip;
-            m_coinTimer = sf::Time::Zero;
+            startCoinFlip(false);
             return true;
         }
     }
 
+    // Keyboard shortcuts: H/T pick the coin side
+    if (m_phase == CombatPhase::PlayerCoinChoice && event.type == sf::Event::KeyPressed &&
+        (event.key.code == sf::Keyboard::H || event.key.code == sf::Keyboard::T)) {
+        startCoinFlip(event.key.code == sf::Keyboard::H);
+        return true;
+    }
+
+    // Keyboard shortcuts: 1-3 pick a skill from the open menu
+    const CombatEngine::State& battle = m_engine.getState();
+    if (battle.skillMenu && event.type == sf::Event::KeyPressed &&
+        event.key.code >= sf::Keyboard::Num1 && event.key.code <= sf::Keyboard::Num3) {
+        int index = event.key.code - sf::Keyboard::Num1;
+        applyAction(static_cast<CombatEngine::Action>(static_cast<int>(CombatEngine::Action::Skill1) + index));
+        return true;
+    }
+
     // Handle skill menu selection
-    if (m_showingSkillMenu && event.type == sf::Event::MouseButtonPressed) {
-        if (m_isDefenseSkillMenu) {
-            for (int i = 0; i < 3; ++i) {
-                if (m_defenseSkillButtons[i].handleEvent(event)) {
-                    applyPikaDefSkill(static_cast<PikaDefSkill>(i));
-                    return true;
-                }
-            }
-        } else {
-            for (int i = 0; i < 3; ++i) {
-                if (m_attackSkillButtons[i].handleEvent(event)) {
-                    applyPikaAtkSkill(static_cast<PikaAtkSkill>(i));
-                    return true;
-                }
+    if (battle.skillMenu && event.type == sf::Event::MouseButtonPressed) {
+        std::vector<UI::Button>& buttons = battle.defending ? m_defenseSkillButtons : m_attackSkillButtons;
+        for (int i = 0; i < 3; ++i) {
+            if (buttons[i].handleEvent(event)) {
+                applyAction(static_cast<CombatEngine::Action>(static_cast<int>(CombatEngine::Action::Skill1) + i));
+                return true;
             }
         }
     }
@@ -261,80 +341,82 @@ bool CombatState::handleEvent(const sf::Event& event) {
     // Handle player action after coin flip
     if (m_phase == CombatPhase::PlayerAction && event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space) {
-            performPlayerAttack();
+            applyAction(CombatEngine::Action::Attack);
             return true;
         }
     }
 
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F1 && !m_engine.isOver()) {
+        showHint();
+        return true;
+    }
+
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::L) {
+        m_logVisible = !m_logVisible;
+        return true;
+    }
+
     // Temporary: Quick combat end for testing
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::V) {
             // V = Victory
-            m_phase = CombatPhase::Victory;
-            m_resultTimer = sf::Time::Zero;
+            m_engine.forceResult(true);
+            enterResultPhase(true);
             return true;
         }
         if (event.key.code == sf::Keyboard::U) {
             // U = Unfortunately
-            m_phase = CombatPhase::Defeat;
-            m_resultTimer = sf::Time::Zero;
-            return true;
-        }
-    }
-
-    if (m_phase == CombatPhase::PlayerAction && m_waitingForInput) {
-        if (m_normalAttackButton.handleEvent(event)) {
+            m_engine.forceResult(false);
+            enterResultPhase(false);
             return true;
         }
-
-        if (m_skillSelectionVisible) {
-            for (auto& button : m_skillButtons) {
-                if (button.handleEvent(event)) {
-                    return true;
-                }
-            }
-        }
     }
 
     return false;
 }
 
-void CombatState::initializeCombat(Player& player, bool isBoss) {
-    m_player = &player;
-    m_isBoss = isBoss;
-
-    if (isBoss) {
-        m_enemy = Boss::createBoss();
-        m_enemyType = "boss";
-    } else {
-        m_enemy = Enemy::createRegularEnemy();
-        m_enemyType = "chalamander"; // Default
-    }
-
-    // Reset to ready banner
-    m_phase = CombatPhase::ReadyBanner;
-    m_bannerTimer = sf::Time::Zero;
-
-    addLogMessage("Combat begins!");
-}
-
-void CombatState::initializeCombat(Player& player, const std::string& enemyType) {
-    m_player = &player;
-    m_enemyType = enemyType;
-
-    if (enemyType == "boss") {
+std::uint64_t CombatState::stateHash() const {
+    std::uint64_t hash = 0;
+    hash = hashCombine(hash, static_cast<std::uint64_t>(m_phase));
+    hash = hashCombine(hash, static_cast<std::uint64_t>(m_monster));
+    const CombatEngine::Fighter& player = m_engine.getState().player;
+    const CombatEngine::Fighter& enemy = m_engine.getState().enemy;
+    hash = hashCombine(hash, static_cast<std::uint32_t>(player.hp));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(player.atk));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(enemy.hp));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(enemy.atk));
+    hash = hashCombine(hash, player.status.pack());
+    hash = hashCombine(hash, enemy.status.pack());
+    return hash;
+}
+
+void CombatState::onCombatStarted(const GameEvent& event) {
+    const GameEvent::CombatStartedData& data = event.combatStarted;
+    m_session = event.session;
+    m_monster = data.monster;
+    m_monsterPos = Vec2i(data.x, data.y);
+
+    switch (m_monster) {
+        case MonsterType::Bisasam: m_enemyType = "bisasam"; break;
+        case MonsterType::Boss:    m_enemyType = "boss"; break;
+        default:                   m_enemyType = "chalamander"; break;
+    }
+    m_isBoss = m_monster == MonsterType::Boss;
+
+    // The encounter's BASE_ENEMY_* / BASE_BOSS_* stats, the ones the balance
+    // tools measure. Only the boss keeps MP for its moves; other enemies keep
+    // to plain attacks, as the tools play them
+    CombatEngine::State battle = CombatEngine::makeEncounterState(encounterFor(m_monster));
+    if (m_isBoss) {
         m_enemy = Boss::createBoss();
-        m_isBoss = true;
     } else {
         m_enemy = Enemy::createRegularEnemy();
-        m_isBoss = false;
+        battle.enemy.mp = 0;
     }
-
-    // Reset to ready banner
-    m_phase = CombatPhase::ReadyBanner;
-    m_bannerTimer = sf::Time::Zero;
-
-    addLogMessage("Combat begins!");
+    m_engine.reset(battle);
+    m_log.clear();
+    logEntry(CombatLog::makeEntry(CombatLogEntry::BattleStart, battle));
+    planEnemyMove();
 }
 
 void CombatState::setupUI() {
@@ -377,357 +459,224 @@ void CombatState::setupUI() {
         m_defenseSkillButtons[i].setFont(assets.getDefaultFont());
     }
     
+    m_logPanel.setPosition(sf::Vector2f(50, 50));
+    m_logPanel.setSize(sf::Vector2f(460, LogLines * 25 + 10));
+    m_logPanel.setFillColor(sf::Color(0, 0, 0, 180));
+    for (std::size_t i = 0; i < LogLines; ++i) {
+        m_logMessages[i].setFont(assets.getDefaultFont());
+        m_logMessages[i].setCharacterSize(14);
+        m_logMessages[i].setPosition(sf::Vector2f(60, 60 + i * 25));
+    }
+
     // Remove old panels - only keep compact stat panels
     
     // Remove old UI elements - only keep coin buttons and skill buttons
 }
 
-void CombatState::updateUI() {
-    if (m_player) {
-        m_playerHPBar.setValues(m_player->getCurrentHP(), m_player->getMaxHP());
-        m_playerMPBar.setValues(m_player->getCurrentMP(), m_player->getMaxMP());
-    }
-    
-    if (m_enemy) {
-        m_enemyHPBar.setValues(m_enemy->getCurrentHP(), m_enemy->getMaxHP());
-        m_enemyMPBar.setValues(m_enemy->getCurrentMP(), m_enemy->getMaxMP());
-        m_enemyNameLabel.setText(m_enemy->getName());
-    }
-}
+void CombatState::resetCombat() {
+    m_enemy.reset();
+    m_isBoss = false;
+    m_session = EventBus::AnySession;
+    m_monster = MonsterType::Chalamander;
+    m_monsterPos = Vec2i(0, 0);
+    m_enemyType = "chalamander";
 
-void CombatState::addLogMessage(const std::string& message) {
-    // Keep only last 5 messages
-    if (m_logMessages.size() >= 5) {
-        m_logMessages.erase(m_logMessages.begin());
-    }
-    
-    UI::TextLabel label;
-    label.setPosition(sf::Vector2f(60, 60 + m_logMessages.size() * 25));
-    label.setFont(getContext().assets->getDefaultFont());
-    label.setCharacterSize(14);
-    label.setText(message);
-    
-    m_logMessages.push_back(label);
-    
-    // Reposition all messages
-    for (size_t i = 0; i < m_logMessages.size(); ++i) {
-        m_logMessages[i].setPosition(sf::Vector2f(60, 60 + i * 25));
-    }
-}
+    m_log.clear();
+    m_logLineCount = 0;
+    m_logRendered = 0;
 
-void CombatState::startPlayerTurn() {
-    m_phase = CombatPhase::PlayerCoinChoice;
+    m_engine.reset();
     m_playerChoice = CoinChoice::None;
-    m_coinResult = CoinResult::None;
-}
-
-void CombatState::startEnemyTurn() {
-    m_phase = CombatPhase::EnemyAction;
-    performEnemyAttack();
-}
+    m_enemyName = "Enemy";
 
-void CombatState::performCoinFlip() {
-    // For now, just randomly decide if player gets skills
-    bool coinResult = getContext().rng->flipCoin();
-    onCoinResult(coinResult);
-}
+    m_combatResult = CombatResult::None;
 
-void CombatState::onCoinResult(bool playerWon) {
-    if (playerWon) {
-        addLogMessage("Coin flip: SUCCESS! You can use skills.");
-        showSkillSelection();
-    } else {
-        addLogMessage("Coin flip: FAILED! Normal attack only.");
-        hideSkillSelection();
-    }
-    
-    m_phase = CombatPhase::PlayerAction;
-    m_waitingForInput = true;
-}
+    m_atkShakePika = Shake();
+    m_atkShakeEnemy = Shake();
+    m_hurtNudgePika = Nudge();
+    m_hurtNudgeEnemy = Nudge();
 
-void CombatState::showSkillSelection() {
-    m_skillSelectionVisible = true;
-    // Setup skill buttons based on available skills
-    // This is simplified for now
+    // Timers left over from the previous encounter must not fire in this one
+    m_tasks.cancelAll();
+    startPhaseTask(playReadyBanner());
 }
 
-void CombatState::hideSkillSelection() {
-    m_skillSelectionVisible = false;
+void CombatState::logEntry(CombatLogEntry entry) {
+    entry.turn = m_log.getTurn();
+    m_log.push(entry);
 }
 
-void CombatState::useSkill(SkillType skillType) {
-    if (m_player && m_player->getPokemon() && m_enemy) {
-        m_player->getPokemon()->useSkill(skillType, *m_enemy);
-        addLogMessage("Player used skill!");
-        m_waitingForInput = false;
-        checkCombatEnd();
-        if (m_phase != CombatPhase::Ended) {
-            startEnemyTurn();
+void CombatState::refreshLogLabels() {
+    // Walk back from the newest entry until the labels are full, then fill
+    // them oldest first
+    std::array<std::string, LogLines> tail;
+    std::size_t count = 0;
+    std::array<std::string, 2> lines;
+    for (std::size_t i = 0; i < m_log.size() && count < LogLines; ++i) {
+        std::size_t lineCount = formatLogEntry(m_log.fromNewest(i), lines);
+        for (std::size_t line = lineCount; line > 0 && count < LogLines; --line) {
+            tail[count++] = std::move(lines[line - 1]);
         }
     }
-}
 
-// Old methods removed - using performPlayerAttack and performEnemyAttack instead
-
-void CombatState::checkCombatEnd() {
-    if (m_enemyHP <= 0) {
-        m_phase = CombatPhase::Victory;
-        m_resultTimer = sf::Time::Zero;
-        addLogMessage("Victory!");
-    } else if (m_playerHP <= 0) {
-        m_phase = CombatPhase::Defeat;
-        m_resultTimer = sf::Time::Zero;
-        addLogMessage("Unfortunately...");
+    for (std::size_t i = 0; i < count; ++i) {
+        m_logMessages[i].setText(tail[count - 1 - i]);
     }
+    m_logLineCount = count;
+    m_logRendered = m_log.getTotal();
 }
 
-// Enhanced combat flow methods
-void CombatState::beginPlayerTurn() {
-    m_phase = CombatPhase::PlayerCoinChoice;
-    m_playerChoice = CoinChoice::None;
-    m_coinResult = CoinResult::None;
-}
-
-void CombatState::resolvePlayerCoin(bool correct) {
-    m_coinCorrect = correct;
-    if (correct) {
-        // Show attack skill menu
-        m_showingSkillMenu = true;
-        m_isDefenseSkillMenu = false;
-    } else {
-        // Normal attack
-        int damage = m_playerATK + (m_playerStatus.type == StatusEffect::ATKBonus ? m_playerStatus.magnitude : 0);
-        m_enemyHP -= damage;
-        if (m_enemyHP < 0) m_enemyHP = 0;
+bool CombatState::applyAction(CombatEngine::Action action) {
+    CombatEngine::StepResult result = m_engine.step(action, *getContext().rng);
+    if (!result.accepted) return false;
 
-        triggerAttackShake(true);
-        triggerHurtNudge(false);
-
-        addLogMessage("Pikachu used Normal Attack for " + std::to_string(damage) + " damage!");
-
-        // Clear ATK bonus after use
-        if (m_playerStatus.type == StatusEffect::ATKBonus) {
-            m_playerStatus = StatusEffect();
-        }
+    m_log.pushStep(result, m_engine.getState());
 
-        checkCombatEnd();
-        if (m_phase != CombatPhase::Victory && m_phase != CombatPhase::Defeat) {
-            beginEnemyTurn();
-        }
+    for (std::uint8_t i = 0; i < result.eventCount; ++i) {
+        presentEvent(result.events[i]);
     }
-}
 
-void CombatState::beginEnemyTurn() {
-    // Check if enemy is stunned
-    if (m_enemyStatus.type == StatusEffect::Stun && m_enemyStatus.duration > 0) {
-        addLogMessage("Enemy is stunned and loses turn!");
-        m_enemyStatus.duration--;
-        if (m_enemyStatus.duration <= 0) {
-            m_enemyStatus = StatusEffect();
-        }
-        beginPlayerTurn();
-        return;
+    // Where the fight goes next is the engine's call; the presenter only adds
+    // its timed phases (banner, flip, result) around it
+    switch (m_engine.getState().phase) {
+        case CombatEngine::Phase::CoinChoice: m_phase = CombatPhase::PlayerCoinChoice; break;
+        case CombatEngine::Phase::Action:     m_phase = CombatPhase::PlayerAction; break;
+        case CombatEngine::Phase::Victory:    m_phase = CombatPhase::Victory; break;
+        case CombatEngine::Phase::Defeat:     m_phase = CombatPhase::Defeat; break;
     }
 
-    // Enemy turn: Player gets to choose defense coin
-    addLogMessage("Enemy's turn! Choose HEAD/TAIL for defense!");
-    m_phase = CombatPhase::PlayerCoinChoice; // Player chooses defense coin
-    m_playerChoice = CoinChoice::None;
-    m_coinResult = CoinResult::None;
-    m_isDefenseSkillMenu = true; // Flag that this is for defense
-}
-
-void CombatState::resolveEnemyCoin(bool correct) {
-    if (correct) {
-        // Show defense skill menu for Pikachu
-        m_showingSkillMenu = true;
-        m_isDefenseSkillMenu = true;
-        addLogMessage("Coin correct! Choose defense skill!");
-    } else {
-        // Take full damage from enemy attack
-        addLogMessage("Coin wrong! Taking full damage!");
-
-        // Enemy 30% dodge chance when defending
-        if (enemyTryDodge()) {
-            addLogMessage("Enemy dodged the attack!");
-            // No damage, just shake enemy slightly
-            triggerAttackShake(false);
-        } else {
-            // Take full enemy attack
-            performEnemyAttack();
-        }
+    if (m_phase == CombatPhase::PlayerCoinChoice) {
+        planEnemyMove();
     }
+    return true;
 }
 
-bool CombatState::enemyTryDodge() {
-    return getContext().rng->rollRange(1, 100) <= 30;
+void CombatState::planEnemyMove() {
+    if (!m_enemy || m_engine.getState().phase != CombatEngine::Phase::CoinChoice) return;
+    m_engine.setEnemyMove(m_enemy->chooseMove(m_engine.getState()));
 }
 
-void CombatState::updateStatusEffects() {
-    // Update player status
-    if (m_playerStatus.type != StatusEffect::None && m_playerStatus.duration > 0) {
-        // Status effects are updated per turn, not per frame
-    }
-
-    // Update enemy status
-    if (m_enemyStatus.type != StatusEffect::None && m_enemyStatus.duration > 0) {
-        // Status effects are updated per turn, not per frame
-    }
-}
+void CombatState::presentEvent(const CombatEngine::Event& event) {
+    // The text is in m_log; this only adds the shakes, sounds and result phase
+    switch (event.type) {
+        case CombatEngine::Event::NormalAttack:
+        case CombatEngine::Event::SkillAttack:
+            triggerAttackShake(true);
+            triggerHurtNudge(false);
+            break;
 
-void CombatState::triggerAttackShake(bool isPlayer) {
-    if (isPlayer) {
-        m_atkShakePika.start(sf::Vector2f(80.0f, getContext().window->getSize().y - 40.0f));
-    } else {
-        m_atkShakeEnemy.start(sf::Vector2f(getContext().window->getSize().x - 80.0f, 80.0f));
-    }
-}
+        case CombatEngine::Event::EnemyDodged:
+            triggerAttackShake(false);
+            break;
 
-void CombatState::triggerHurtNudge(bool isPlayer) {
-    if (isPlayer) {
-        m_hurtNudgePika.start(sf::Vector2f(-1, 0)); // Nudge left
-    } else {
-        m_hurtNudgeEnemy.start(sf::Vector2f(1, 0)); // Nudge right
-    }
-}
+        case CombatEngine::Event::EnemyAttack:
+        case CombatEngine::Event::PlayerDamaged:
+            triggerAttackShake(false);
+            triggerHurtNudge(true);
+            break;
 
-// Skill implementations
-void CombatState::applyPikaAtkSkill(PikaAtkSkill skill) {
-    int damage = 0;
-    std::string skillName;
-
-    switch (skill) {
-        case PikaAtkSkill::Thunderbolt:
-            damage = static_cast<int>(m_playerATK * 2.0f);
-            skillName = "Thunderbolt";
-            // 20% chance to stun
-            if (getContext().rng->rollRange(1, 100) <= 20) {
-                m_enemyStatus = StatusEffect(StatusEffect::Stun, 1);
-                addLogMessage("Enemy is stunned!");
-            }
+        case CombatEngine::Event::Victory:
+            enterResultPhase(true);
             break;
 
-        case PikaAtkSkill::ElectroBall:
-            {
-                int hpLost = m_enemyMaxHP - m_enemyHP;
-                damage = m_playerATK + static_cast<int>(0.15f * hpLost);
-                skillName = "Electro Ball";
-            }
+        case CombatEngine::Event::Defeat:
+            enterResultPhase(false);
             break;
 
-        case PikaAtkSkill::VoltTackle:
-            damage = static_cast<int>(m_playerATK * 2.5f);
-            skillName = "Volt Tackle";
-            // 10% recoil damage
-            int recoil = static_cast<int>(damage * 0.1f);
-            m_playerHP -= recoil;
-            if (m_playerHP < 0) m_playerHP = 0;
-            addLogMessage("Pikachu takes " + std::to_string(recoil) + " recoil damage!");
+        default:
             break;
     }
+}
 
-    // Apply ATK bonus if active
-    if (m_playerStatus.type == StatusEffect::ATKBonus) {
-        damage += m_playerStatus.magnitude;
-        m_playerStatus = StatusEffect(); // Clear after use
-    }
+void CombatState::showHint() {
+    const CombatEngine::State& battle = m_engine.getState();
+    CombatSolver::Advice advice = m_solver.advise(battle);
 
-    m_enemyHP -= damage;
-    if (m_enemyHP < 0) m_enemyHP = 0;
+    CombatLogEntry entry = CombatLog::makeEntry(CombatLogEntry::Hint, battle);
+    entry.hintAction = static_cast<std::uint8_t>(advice.action);
+    entry.hintWinPercent = static_cast<std::uint8_t>(advice.winChance * 100.0 + 0.5);
+    logEntry(entry);
+}
 
-    triggerAttackShake(true);
-    triggerHurtNudge(false);
+void CombatState::startPhaseTask(TaskScheduler::Task task) {
+    m_tasks.cancel(m_phaseTask);
+    m_phaseTask = m_tasks.spawn(std::move(task));
+}
 
-    addLogMessage("Pikachu used " + skillName + " for " + std::to_string(damage) + " damage!");
+void CombatState::startCoinFlip(bool head) {
+    m_playerChoice = head ? CoinChoice::Head : CoinChoice::Tail;
+    m_phase = CombatPhase::PlayerCoinFlip;
+    startPhaseTask(flipCoin());
+}
 
-    m_showingSkillMenu = false;
-    checkCombatEnd();
-    if (m_phase != CombatPhase::Victory && m_phase != CombatPhase::Defeat) {
-        beginEnemyTurn();
+void CombatState::enterResultPhase(bool victory) {
+    m_phase = victory ? CombatPhase::Victory : CombatPhase::Defeat;
+    startPhaseTask(showResult());
+}
+
+TaskScheduler::Task CombatState::playReadyBanner() {
+    m_phase = CombatPhase::ReadyBanner;
+    co_await m_tasks.wait(m_bannerDuration);
+
+    if (m_phase == CombatPhase::ReadyBanner) {
+        m_phase = CombatPhase::PlayerCoinChoice;
     }
 }
 
-void CombatState::applyPikaDefSkill(PikaDefSkill skill) {
-    std::string skillName;
-    int enemyDamage = m_enemyATK;
-    int finalDamage = enemyDamage;
+TaskScheduler::Task CombatState::flipCoin() {
+    co_await m_tasks.wait(m_coinDuration);
+    if (m_phase != CombatPhase::PlayerCoinFlip) co_return;
 
-    switch (skill) {
-        case PikaDefSkill::QuickGuard:
-            finalDamage = static_cast<int>(enemyDamage * 0.5f);
-            skillName = "Quick Guard";
-            addLogMessage("Pikachu used Quick Guard! Damage reduced by 50%!");
-            break;
+    // The coin lands: the engine rolls it and resolves the call (attack or defense)
+    applyAction(m_playerChoice == CoinChoice::Head ? CombatEngine::Action::CallHead : CombatEngine::Action::CallTail);
+}
 
-        case PikaDefSkill::Agility:
-            finalDamage = 0;
-            skillName = "Agility";
-            addLogMessage("Pikachu used Agility! Attack dodged completely!");
-            break;
+TaskScheduler::Task CombatState::showResult() {
+    co_await m_tasks.wait(m_resultDuration);
+    if (m_phase != CombatPhase::Victory && m_phase != CombatPhase::Defeat) co_return;
 
-        case PikaDefSkill::Charge:
-            finalDamage = static_cast<int>(enemyDamage * 0.7f);
-            m_playerStatus = StatusEffect(StatusEffect::ATKBonus, 1, 10);
-            skillName = "Charge";
-            addLogMessage("Pikachu used Charge! Damage reduced and ATK boosted!");
-            break;
-    }
+    CombatResult result = m_phase == CombatPhase::Victory ? CombatResult::Victory : CombatResult::Unfortunately;
+    m_phase = CombatPhase::Ended;
+    m_combatResult = result;
 
-    m_playerHP -= finalDamage;
-    if (m_playerHP < 0) m_playerHP = 0;
+    getContext().events->publish(
+        GameEvent::makeCombatEnded(m_session, result, m_monster, m_monsterPos));
 
-    if (finalDamage > 0) {
-        triggerAttackShake(false);
-        triggerHurtNudge(true);
-        addLogMessage("Pikachu takes " + std::to_string(finalDamage) + " damage!");
-    }
+#ifdef ENABLE_COMBAT_EXPORT
+    m_log.appendBattle(Constants::COMBAT_EXPORT_PATH, m_session, static_cast<std::uint8_t>(m_monster),
+                       static_cast<std::uint8_t>(result));
+#endif
 
-    m_showingSkillMenu = false;
-    checkCombatEnd();
-    if (m_phase != CombatPhase::Victory && m_phase != CombatPhase::Defeat) {
-        beginPlayerTurn();
-    }
+    std::cout << "CombatState: Setting result to " << (result == CombatResult::Victory ? "Victory" : "Unfortunately") << std::endl;
+
+    requestStackPop();
 }
 
-void CombatState::endCombat(CombatResult result) {
-    m_phase = CombatPhase::Ended;
-    
-    switch (result) {
-        case CombatResult::Victory:
-            if (m_isBoss) {
-                addLogMessage("Boss defeated! Victory!");
-                requestStateClear();
-                requestStackPush(StateID::Victory);
-            } else {
-                addLogMessage("Enemy defeated!");
-                if (m_player) {
-                    m_player->addVictory();
-                }
-                requestStackPop(); // Return to map
-            }
-            break;
-        case CombatResult::Unfortunately:
-            addLogMessage("You were defeated!");
-            requestStateClear();
-            requestStackPush(StateID::GameOver);
-            break;
-        default:
-            break;
+void CombatState::triggerAttackShake(bool isPlayer) {
+    // Runs on the simulation thread, which must not touch the window: the
+    // sprite anchors come from the logical screen size instead
+    if (isPlayer) {
+        m_atkShakePika.start(sf::Vector2f(80.0f, Constants::SCREEN_HEIGHT - 40.0f));
+    } else {
+        m_atkShakeEnemy.start(sf::Vector2f(Constants::SCREEN_WIDTH - 80.0f, 80.0f));
     }
 }
 
-void CombatState::onNormalAttackSelected() {
-    performPlayerAttack();
-}
+void CombatState::triggerHurtNudge(bool isPlayer) {
+    // Hits can land in quick succession, so give them priority over UI sounds
+    getContext().audio->playSound(m_hitSound, AudioManager::Priority::High);
 
-void CombatState::onSkillSelected(SkillType skillType) {
-    useSkill(skillType);
+    if (isPlayer) {
+        m_hurtNudgePika.start(sf::Vector2f(-1, 0)); // Nudge left
+    } else {
+        m_hurtNudgeEnemy.start(sf::Vector2f(1, 0)); // Nudge right
+    }
 }
 
-void CombatState::drawCombatSprites(sf::RenderWindow& window, const AssetManager& assets) {
-    sf::Vector2u winSize = window.getSize();
+void CombatState::drawCombatSprites(RenderList& target, const AssetManager& assets) {
+    sf::Vector2u winSize = target.getSize();
 
-    // Fixed sprite heights (no scaling based on window size)
+    // Fixed sprite heights (no scaling based on target size)
     const float PIKACHU_HEIGHT = 300.0f;  // ±20 as per spec
     const float ENEMY_HEIGHT = 320.0f;    // ±20 as per spec
     const float MARGIN_X = 80.0f;
@@ -746,8 +695,9 @@ void CombatState::drawCombatSprites(sf::RenderWindow& window, const AssetManager
     float playerScale = PIKACHU_HEIGHT / playerTexSize.y;
     playerSprite.setScale(playerScale, playerScale);
 
-    // Apply shake and nudge offsets
-    sf::Vector2f playerOffset = m_atkShakePika.getOffset() + m_hurtNudgePika.getOffset();
+    // Apply shake and nudge offsets, evaluated at the render time between ticks
+    const float ahead = target.getInterpolation() / Constants::TARGET_FPS;
+    sf::Vector2f playerOffset = m_atkShakePika.getOffset(ahead) + m_hurtNudgePika.getOffset(ahead);
     sf::Vector2f finalPlayerPos = playerBasePos + playerOffset;
 
     // Manual bottom-left positioning
@@ -760,7 +710,7 @@ void CombatState::drawCombatSprites(sf::RenderWindow& window, const AssetManager
     // Enable alpha blending
     sf::RenderStates playerStates;
     playerStates.blendMode = sf::BlendAlpha;
-    window.draw(playerSprite, playerStates);
+    target.draw(playerSprite, playerStates);
 
     // Create enemy sprite - fixed height, top-right anchor
     std::string enemyKey = "monster_" + m_enemyType;
@@ -772,7 +722,7 @@ void CombatState::drawCombatSprites(sf::RenderWindow& window, const AssetManager
     enemySprite.setScale(enemyScale, enemyScale);
 
     // Apply shake and nudge offsets
-    sf::Vector2f enemyOffset = m_atkShakeEnemy.getOffset() + m_hurtNudgeEnemy.getOffset();
+    sf::Vector2f enemyOffset = m_atkShakeEnemy.getOffset(ahead) + m_hurtNudgeEnemy.getOffset(ahead);
     sf::Vector2f finalEnemyPos = enemyBasePos + enemyOffset;
 
     // Manual top-right positioning
@@ -785,49 +735,5 @@ void CombatState::drawCombatSprites(sf::RenderWindow& window, const AssetManager
     // Enable alpha blending for enemy sprite
     sf::RenderStates enemyStates;
     enemyStates.blendMode = sf::BlendAlpha;
-    window.draw(enemySprite, enemyStates);
-}
-
-void CombatState::performPlayerAttack() {
-    int damage = m_coinCorrect ? (m_playerATK * 2) : m_playerATK; // Special vs Normal
-    m_enemyHP -= damage;
-    if (m_enemyHP < 0) m_enemyHP = 0;
-
-    addLogMessage(m_coinCorrect ? "Pikachu used Special Attack!" : "Pikachu used Normal Attack!");
-    addLogMessage("Enemy takes " + std::to_string(damage) + " damage!");
-
-    checkCombatEnd();
-    if (m_phase != CombatPhase::Victory && m_phase != CombatPhase::Defeat) {
-        m_phase = CombatPhase::EnemyAction;
-        performEnemyAttack();
-    }
+    target.draw(enemySprite, enemyStates);
 }
-
-void CombatState::performEnemyAttack() {
-    // Enemy only has normal attack (as per spec)
-    int damage = m_enemyATK;
-
-    // Check if player has defense skill active or enemy dodges
-    bool playerDodged = false;
-
-    // Apply any active defense effects would be handled in resolveEnemyCoin
-    // For now, just do normal attack
-
-    triggerAttackShake(false);  // Enemy attacks
-    triggerHurtNudge(true);     // Player gets hurt
-
-    m_playerHP -= damage;
-    if (m_playerHP < 0) m_playerHP = 0;
-
-    addLogMessage("Enemy attacks for " + std::to_string(damage) + " damage!");
-
-    checkCombatEnd();
-    if (m_phase != CombatPhase::Victory && m_phase != CombatPhase::Defeat) {
-        // Reset for next player turn
-        m_playerChoice = CoinChoice::None;
-        m_coinResult = CoinResult::None;
-        m_phase = CombatPhase::PlayerCoinChoice;
-    }
-}
-
-
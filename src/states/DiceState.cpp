@@ -1,4 +1,5 @@
 #include "states/DiceState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
@@ -13,6 +14,7 @@ DiceState::DiceState(StateStack& stack, Context context)
     , m_totalAnimationTime(sf::milliseconds(Constants::DICE_ANIMATION_TIME))
     , m_animating(false)
     , m_finalResult(1)
+    , m_diceSound(context.audio->loadSound(Constants::SFX_DICE))
 {
     AssetManager& assets = *getContext().assets;
     
@@ -31,16 +33,14 @@ DiceState::DiceState(StateStack& stack, Context context)
     startAnimation();
 }
 
-void DiceState::draw() {
-    sf::RenderWindow& window = *getContext().window;
-    
+void DiceState::draw(RenderList& target) {
     // Draw semi-transparent background
     sf::RectangleShape background(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     background.setFillColor(sf::Color(0, 0, 0, 128));
-    window.draw(background);
+    target.draw(background);
     
-    m_diceLabel.draw(window);
-    m_instructionLabel.draw(window);
+    m_diceLabel.draw(target);
+    m_instructionLabel.draw(target);
 }
 
 bool DiceState::update(sf::Time dt) {
@@ -85,7 +85,7 @@ void DiceState::startAnimation() {
     m_finalResult = getContext().rng->rollD6();
     
     // Play dice sound
-    getContext().audio->playSound(Constants::SFX_DICE);
+    getContext().audio->playSound(m_diceSound);
 }
 
 void DiceState::finishAnimation() {
@@ -1,4 +1,5 @@
 #include "states/GameOverState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
@@ -12,18 +13,16 @@ GameOverState::GameOverState(StateStack& stack, Context context)
     setupUI();
 }
 
-void GameOverState::draw() {
-    sf::RenderWindow& window = *getContext().window;
-    
+void GameOverState::draw(RenderList& target) {
     // Draw background
     sf::RectangleShape background(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     background.setFillColor(sf::Color(40, 20, 20));
-    window.draw(background);
+    target.draw(background);
     
-    m_titleLabel.draw(window);
-    m_messageLabel.draw(window);
-    m_retryButton.draw(window);
-    m_exitButton.draw(window);
+    m_titleLabel.draw(target);
+    m_messageLabel.draw(target);
+    m_retryButton.draw(target);
+    m_exitButton.draw(target);
 }
 
 bool GameOverState::update(sf::Time dt) {
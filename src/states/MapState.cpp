@@ -1,13 +1,16 @@
 #include "states/MapState.h"
-#include "states/CombatState.h"
+#include "core/RenderList.h"
+#include "core/Profiler.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "ui/TextLabel.h"
 #include "ui/Button.h"
 #include "ui/Bar.h"
 #include "core/AssetManager.h"
+#include "core/AudioManager.h"
 #include "core/RNG.h"
 #include "core/SaveSystem.h"
+#include "core/JobSystem.h"
 #include <algorithm>
 #include <string>
 #include <iostream>
@@ -17,63 +20,75 @@ MapState::MapState(StateStack& stack, Context context)
     , m_canRoll(true)
     , m_remainingSteps(0)
     , m_autoPathActive(false)
-    , m_stepTimer(sf::Time::Zero)
     , m_stepDelay(sf::milliseconds(500))  // 0.5s per step
+    , m_walkTask(0)
     , m_justTeleported(false)
-    , m_combatMonsterPos(0, 0)
+    , m_session(context.events->newSession())
+    , m_combatEndedSub(0)
+    , m_saveRequestedSub(0)
 {
     setupUI();
 
+    EventBus& events = *context.events;
+    m_combatEndedSub = events.subscribe(GameEvent::Type::CombatEnded, [this](const GameEvent& event) {
+        if (event.session != m_session) return;
+        onCombatEnded(event.combatEnded.result, Vec2i(event.combatEnded.x, event.combatEnded.y));
+        getContext().audio->playMusic(Constants::BGM_MAP);
+    });
+    m_saveRequestedSub = events.subscribe(GameEvent::Type::SaveRequested, [this](const GameEvent& event) {
+        if (event.session != m_session && event.session != EventBus::AnySession) return;
+        saveGame();
+    });
+
     // Initialize new game by default
     initializeNewGame(PokemonType::Fire);
+
+    getContext().audio->playMusic(Constants::BGM_MAP);
+    getContext().audio->prefetchMusic(Constants::BGM_COMBAT);
 }
 
-void MapState::draw() {
-    sf::RenderWindow& window = *getContext().window;
+MapState::~MapState() {
+    getContext().events->unsubscribe(m_combatEndedSub);
+    getContext().events->unsubscribe(m_saveRequestedSub);
+}
+
+void MapState::draw(RenderList& target) {
+    PROFILE_SCOPE("MapState::draw");
 
     // Set the game view
-    window.setView(m_gameView);
+    target.setView(m_gameView);
 
     // Draw map with sprites
-    m_map.drawWithSprites(window, m_gameView, *getContext().assets);
+    m_map.drawWithSprites(target, m_gameView, *getContext().assets);
 
     // Draw visited tiles overlay
-    m_map.drawVisitedTiles(window, m_player);
+    m_map.drawVisitedTiles(target, m_player);
 
     // Draw player sprite
-    m_map.drawPlayer(window, m_player.getMapPosition(), *getContext().assets);
+    m_map.drawPlayer(target, m_player.getMapPosition(), *getContext().assets);
 
     // Reset to default view for UI
-    window.setView(window.getDefaultView());
+    target.setView(target.getDefaultView());
 
     // Draw UI
-    m_positionLabel.draw(window);
-    m_directionLabel.draw(window);
-    m_levelLabel.draw(window);
-    m_victoriesLabel.draw(window);
-    m_rollButton.draw(window);
-    m_hpBar.draw(window);
-    m_mpBar.draw(window);
+    m_positionLabel.draw(target);
+    m_directionLabel.draw(target);
+    m_levelLabel.draw(target);
+    m_victoriesLabel.draw(target);
+    m_rollButton.draw(target);
+    m_hpBar.draw(target);
+    m_mpBar.draw(target);
 }
 
 bool MapState::update(sf::Time dt) {
-    // Check for combat result from CombatState
-    if (CombatState::s_combatJustEnded) {
-        std::cout << "Combat just ended, processing result..." << std::endl;
-        onCombatEnded(CombatState::s_lastCombatResult);
-
-        // Reset the flag
-        CombatState::s_combatJustEnded = false;
-        CombatState::s_lastCombatResult = CombatResult::None;
-    }
-
+    PROFILE_SCOPE("MapState::update");
     m_player.update(dt);
     m_rollButton.update(dt);
     m_hpBar.update(dt);
     m_mpBar.update(dt);
 
-    // Update auto-path system
-    updateAutoPath(dt);
+    // Advance the auto-path walk
+    m_tasks.advance(dt);
 
     updateUI();
     centerCameraOnPlayer();
@@ -97,12 +112,37 @@ bool MapState::handleEvent(const sf::Event& event) {
             requestStackPush(StateID::Pause);
             return true;
         }
-        // Combat result is now handled automatically through static variables
+        // Combat results arrive through the event bus (CombatEnded)
     }
 
     return false;
 }
 
+bool MapState::isAnimating() const {
+    // Waiting for a roll is static; walking, bar tweens and a save in flight are not
+    return m_autoPathActive || m_hpBar.isAnimating() || m_mpBar.isAnimating() || !m_pendingSave.isDone();
+}
+
+std::uint64_t MapState::stateHash() const {
+    std::uint64_t hash = 0;
+    Vec2i pos = m_player.getMapPosition();
+    hash = hashCombine(hash, static_cast<std::uint32_t>(pos.x));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(pos.y));
+    hash = hashCombine(hash, static_cast<std::uint64_t>(m_player.getDirection()));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(m_player.getCurrentHP()));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(m_player.getLevel()));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(m_player.getVictories()));
+    hash = hashCombine(hash, static_cast<std::uint32_t>(m_remainingSteps));
+    hash = hashCombine(hash, (m_canRoll ? 1u : 0u) | (m_autoPathActive ? 2u : 0u));
+
+    // Defeated monsters are cleared from the map, so the list tracks progress
+    for (const Vec2i& monster : m_map.getMonsterPositions()) {
+        hash = hashCombine(hash, static_cast<std::uint32_t>(monster.x));
+        hash = hashCombine(hash, static_cast<std::uint32_t>(monster.y));
+    }
+    return hash;
+}
+
 void MapState::initializeNewGame(PokemonType pokemonType) {
     // TODO: Use pokemonType to create appropriate Pokemon
     (void)pokemonType; // Suppress unused parameter warning
@@ -126,6 +166,7 @@ void MapState::initializeNewGame(PokemonType pokemonType) {
     m_canRoll = true;
 
     // Reset auto-path state
+    m_tasks.cancelAll();
     m_remainingSteps = 0;
     m_autoPathActive = false;
     m_justTeleported = false;
@@ -150,8 +191,13 @@ void MapState::loadGame(const SaveData& saveData) {
 }
 
 void MapState::saveGame() {
+    // Snapshot here; JSON serialization and the file write run on a worker,
+    // chained after any save still in flight so writes land in order
     SaveData saveData = m_player.createSaveData();
-    getContext().save->saveGame(saveData);
+    SaveSystem* save = getContext().save;
+    m_pendingSave = getContext().jobs->schedule([save, saveData]() {
+        save->saveGame(saveData);
+    }, {m_pendingSave});
 }
 
 void MapState::rollDice() {
@@ -214,10 +260,10 @@ void MapState::handleTileEvent(TileType tileType) {
             handlePortalTeleport();
             break;
         case TileType::Enemy:
-            requestStackPush(StateID::Combat);
+            startCombat(MonsterType::Chalamander, m_player.getMapPosition());
             break;
         case TileType::Boss:
-            requestStackPush(StateID::Combat);
+            startCombat(MonsterType::Boss, m_player.getMapPosition());
             break;
         case TileType::Goal:
             // Reached goal - victory!
@@ -249,51 +295,61 @@ void MapState::handleGoalReached() {
 void MapState::startAutoPath(int steps) {
     m_remainingSteps = steps;
     m_autoPathActive = true;
-    m_stepTimer = sf::Time::Zero;
     m_justTeleported = false;
-}
 
-void MapState::updateAutoPath(sf::Time dt) {
-    if (!m_autoPathActive || m_remainingSteps <= 0) {
-        if (m_autoPathActive && m_remainingSteps <= 0) {
-            m_autoPathActive = false;
-            m_canRoll = true;  // Allow next dice roll
-        }
-        return;
-    }
+    m_tasks.cancel(m_walkTask);
+    m_walkTask = m_tasks.spawn(walkPath());
+}
 
-    m_stepTimer += dt;
-    if (m_stepTimer >= m_stepDelay) {
-        m_stepTimer = sf::Time::Zero;
+// One step every m_stepDelay until the roll is used up. Combat, the goal and
+// combat results stop the walk by clearing m_autoPathActive.
+TaskScheduler::Task MapState::walkPath() {
+    while (m_autoPathActive && m_remainingSteps > 0) {
+        co_await m_tasks.wait(m_stepDelay);
+        if (!m_autoPathActive) co_return;
 
         // Try to take one step
         auto nextPos = pickNextPosition();
-        if (nextPos.has_value()) {
-            // Move to next position
-            Vec2i oldPos = m_player.getMapPosition();
-            m_player.setMapPosition(*nextPos);
-            m_player.markVisited(*nextPos);
-            std::cout << "Marked visited: (" << nextPos->x << "," << nextPos->y << ")" << std::endl;
-
-            // Update world coordinates
-            m_player.setPosition(
-                nextPos->x * Constants::TILE_SIZE + Constants::TILE_SIZE / 2.0f,
-                nextPos->y * Constants::TILE_SIZE + Constants::TILE_SIZE / 2.0f
-            );
-
-            m_remainingSteps--;
-
-            // Check for events after movement
-            checkCombatTrigger();
-            checkGoalReached();
-        } else {
+        if (!nextPos.has_value()) {
             // No valid move - end turn
             m_remainingSteps = 0;
-            m_autoPathActive = false;
-            m_canRoll = true;
+            endTurn();
+            co_return;
+        }
+
+        // Move to next position
+        Vec2i oldPos = m_player.getMapPosition();
+        m_player.setMapPosition(*nextPos);
+        m_player.markVisited(*nextPos);
+        std::cout << "Marked visited: (" << nextPos->x << "," << nextPos->y << ")" << std::endl;
+
+        // Update world coordinates
+        m_player.setPosition(
+            nextPos->x * Constants::TILE_SIZE + Constants::TILE_SIZE / 2.0f,
+            nextPos->y * Constants::TILE_SIZE + Constants::TILE_SIZE / 2.0f
+        );
+
+        m_remainingSteps--;
+
+        // Check for events after movement
+        checkCombatTrigger();
+        checkGoalReached();
+    }
+
+    // Out of steps: the turn ends on the following tick
+    if (m_autoPathActive) {
+        co_await m_tasks.nextTick();
+        if (m_autoPathActive) {
+            endTurn();
         }
     }
 }
+
+void MapState::endTurn() {
+    m_autoPathActive = false;
+    m_canRoll = true;  // Allow next dice roll
+    getContext().events->publish(GameEvent::makeTurnCompleted(m_session));
+}
 std::optional<Vec2i> MapState::pickNextPosition() {
     Vec2i current = m_player.getMapPosition();
 
@@ -385,21 +441,17 @@ void MapState::checkCombatTrigger() {
             m_remainingSteps = 0; // Stop auto-path
             m_canRoll = false; // Disable dice rolling during combat
 
-            // Store monster position for combat result handling
-            m_combatMonsterPos = monsterPos;
-
             // Don't move player yet - keep at current position during combat
 
             // Determine enemy type based on position
-            std::string enemyType = "chalamander"; // Default
+            MonsterType monster = MonsterType::Chalamander; // Default
             if (monsterPos == Vec2i(20, 5)) {
-                enemyType = "chalamander"; // Charmander
+                monster = MonsterType::Chalamander; // Charmander
             } else if (monsterPos == Vec2i(8, 22)) {
-                enemyType = "bisasam"; // Bulbasaur
+                monster = MonsterType::Bisasam; // Bulbasaur
             }
 
-            // Push combat state
-            requestStackPush(StateID::Combat);
+            startCombat(monster, monsterPos);
             return;
         }
     }
@@ -420,16 +472,22 @@ void MapState::checkGoalReached() {
     }
 }
 
-void MapState::onCombatEnded(CombatResult result) {
+void MapState::startCombat(MonsterType monster, const Vec2i& monsterPos) {
+    // CombatState picks up the encounter from the event and echoes the position back
+    getContext().events->publish(GameEvent::makeCombatStarted(m_session, monster, monsterPos));
+    requestStackPush(StateID::Combat);
+}
+
+void MapState::onCombatEnded(CombatResult result, const Vec2i& monsterPos) {
     Vec2i currentPos = m_player.getMapPosition();
 
     std::cout << "Combat ended with result: " << (result == CombatResult::Victory ? "Victory" : "Unfortunately") << std::endl;
     std::cout << "Player position: " << currentPos.x << ", " << currentPos.y << std::endl;
-    std::cout << "Monster position: " << m_combatMonsterPos.x << ", " << m_combatMonsterPos.y << std::endl;
+    std::cout << "Monster position: " << monsterPos.x << ", " << monsterPos.y << std::endl;
 
     if (result == CombatResult::Victory) {
         // Step 1: Remove the defeated monster from map
-        Vec2i defeatedMonsterPos = m_combatMonsterPos; // Use stored monster position
+        Vec2i defeatedMonsterPos = monsterPos;
 
         // Remove monster from map's monster list
         auto& monsterPositions = m_map.getMonsterPositions();
@@ -438,6 +496,13 @@ void MapState::onCombatEnded(CombatResult result) {
             monsterPositions.erase(it);
         }
 
+        TileType oldTile = m_map.getTileType(defeatedMonsterPos);
+        if (oldTile == TileType::Enemy) {
+            m_map.setTileType(defeatedMonsterPos, TileType::Empty);
+            getContext().events->publish(
+                GameEvent::makeTileChanged(m_session, defeatedMonsterPos, oldTile, TileType::Empty));
+        }
+
         // Step 2: Move player to monster position and mark it visited
         m_player.setMapPosition(defeatedMonsterPos);
         m_player.setPosition(
@@ -492,6 +557,9 @@ void MapState::onCombatEnded(CombatResult result) {
     // Force UI update
     updateUI();
 
+    // The combat interrupted this turn's walk, so it ends here
+    getContext().events->publish(GameEvent::makeTurnCompleted(m_session));
+
     std::cout << "Combat result processed. Dice rolling re-enabled." << std::endl;
 }
 
@@ -1,7 +1,9 @@
 #include "states/MenuState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
+#include "core/AudioManager.h"
 #include "core/SaveSystem.h"
 #include <iostream>
 
@@ -12,26 +14,27 @@ MenuState::MenuState(StateStack& stack, Context context)
     , m_selectedPokemon(0)
 {
     setupUI();
+
+    getContext().audio->playMusic(Constants::BGM_MENU);
+    getContext().audio->prefetchMusic(Constants::BGM_MAP);
 }
 
-void MenuState::draw() {
-    sf::RenderWindow& window = *getContext().window;
-    
+void MenuState::draw(RenderList& target) {
     // Draw background
-    window.draw(m_backgroundSprite);
+    target.draw(m_backgroundSprite);
     
     // Draw title
-    m_titleLabel.draw(window);
+    m_titleLabel.draw(target);
     
     if (!m_showPokemonSelection) {
         // Draw main menu buttons
         for (const auto& button : m_buttons) {
-            button.draw(window);
+            button.draw(target);
         }
     } else {
         // Draw pokemon selection
         for (const auto& button : m_pokemonButtons) {
-            button.draw(window);
+            button.draw(target);
         }
     }
 }
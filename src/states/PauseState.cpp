@@ -1,7 +1,9 @@
 #include "states/PauseState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
+#include "core/EventBus.h"
 #include "core/SaveSystem.h"
 #include "ui/TextLabel.h"
 #include "ui/Button.h"
@@ -13,18 +15,16 @@ PauseState::PauseState(StateStack& stack, Context context)
     setupUI();
 }
 
-void PauseState::draw() {
-    sf::RenderWindow& window = *getContext().window;
-    
+void PauseState::draw(RenderList& target) {
     // Draw semi-transparent background
     sf::RectangleShape background(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     background.setFillColor(sf::Color(0, 0, 0, 128));
-    window.draw(background);
+    target.draw(background);
     
-    m_titleLabel.draw(window);
-    m_resumeButton.draw(window);
-    m_saveButton.draw(window);
-    m_mainMenuButton.draw(window);
+    m_titleLabel.draw(target);
+    m_resumeButton.draw(target);
+    m_saveButton.draw(target);
+    m_mainMenuButton.draw(target);
 }
 
 bool PauseState::update(sf::Time dt) {
@@ -115,8 +115,8 @@ void PauseState::onResume() {
 }
 
 void PauseState::onSave() {
-    // Save game functionality would be implemented here
-    // For now, just show a message and resume
+    // The map state under us owns the save data and handles the request
+    getContext().events->publish(GameEvent::makeSaveRequested(EventBus::AnySession));
     requestStackPop();
 }
 
@@ -1,4 +1,5 @@
 #include "states/ReadyState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
@@ -14,17 +15,15 @@ ReadyState::ReadyState(StateStack& stack, Context context)
     setupUI();
 }
 
-void ReadyState::draw() {
-    auto& window = *getContext().window;
-    
+void ReadyState::draw(RenderList& target) {
     // Draw semi-transparent background
     sf::RectangleShape background(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     background.setFillColor(sf::Color(0, 0, 0, 180));
-    window.draw(background);
+    target.draw(background);
     
     // Draw UI elements
-    m_readyLabel.draw(window, sf::RenderStates::Default);
-    m_countdownLabel.draw(window, sf::RenderStates::Default);
+    m_readyLabel.draw(target, sf::RenderStates::Default);
+    m_countdownLabel.draw(target, sf::RenderStates::Default);
 }
 
 bool ReadyState::update(sf::Time dt) {
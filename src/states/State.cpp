@@ -4,14 +4,18 @@
 #include "core/AssetManager.h"
 #include "core/RNG.h"
 #include "core/SaveSystem.h"
+#include "core/EventBus.h"
+#include "core/JobSystem.h"
 
 State::Context::Context(sf::RenderWindow& window, AudioManager& audio, AssetManager& assets, 
-                       RNG& rng, SaveSystem& save)
+                       RNG& rng, SaveSystem& save, EventBus& events, JobSystem& jobs)
     : window(&window)
     , audio(&audio)
     , assets(&assets)
     , rng(&rng)
     , save(&save)
+    , events(&events)
+    , jobs(&jobs)
 {
 }
 
@@ -1,4 +1,5 @@
 #include "states/VictoryState.h"
+#include "core/RenderList.h"
 #include "StateStack.h"
 #include "Constants.h"
 #include "core/AssetManager.h"
@@ -11,17 +12,15 @@ VictoryState::VictoryState(StateStack& stack, Context context)
     setupUI();
 }
 
-void VictoryState::draw() {
-    sf::RenderWindow& window = *getContext().window;
-    
+void VictoryState::draw(RenderList& target) {
     // Draw background
     sf::RectangleShape background(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     background.setFillColor(sf::Color(20, 40, 20));
-    window.draw(background);
+    target.draw(background);
     
-    m_titleLabel.draw(window);
-    m_messageLabel.draw(window);
-    m_exitButton.draw(window);
+    m_titleLabel.draw(target);
+    m_messageLabel.draw(target);
+    m_exitButton.draw(target);
 }
 
 bool VictoryState::update(sf::Time dt) {
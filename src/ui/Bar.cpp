@@ -1,4 +1,5 @@
 #include "ui/Bar.h"
+#include "core/RenderList.h"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -145,7 +146,11 @@ void Bar::update(sf::Time dt) {
     }
 }
 
-void Bar::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+bool Bar::isAnimating() const {
+    return m_animated && std::abs(m_displayValue - m_currentValue) > 0.1f;
+}
+
+void Bar::draw(RenderList& target, sf::RenderStates states) const {
     target.draw(m_background, states);
     target.draw(m_fill, states);
     
@@ -1,4 +1,5 @@
 #include "ui/Button.h"
+#include "core/RenderList.h"
 #include <iostream>
 
 namespace UI {
@@ -136,7 +137,7 @@ void Button::update(sf::Time dt) {
     (void)dt; // TODO: Animation or other updates can go here
 }
 
-void Button::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+void Button::draw(RenderList& target, sf::RenderStates states) const {
     target.draw(m_shape, states);
     target.draw(m_text, states);
 }
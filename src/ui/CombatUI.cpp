@@ -1,9 +1,21 @@
 #include "ui/CombatUI.h"
-#include <sstream>
+#include "core/LinearArena.h"
+#include "core/RenderList.h"
+#include <charconv>
+#include <string>
+
+namespace {
+    // Panel text is rebuilt every frame; its scratch strings live in the frame arena
+    void appendInt(std::pmr::string& out, int value) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+}
 
 namespace CombatUI {
 
-void drawStatPanelTopLeft(sf::RenderTarget& target, const StatData& stats, const sf::Font& font,
+void drawStatPanelTopLeft(RenderList& target, const StatData& stats, const sf::Font& font,
                          sf::Vector2f position, sf::Vector2f size) {
     // Use fixed position with 20px padding from top-left
     sf::Vector2f panelPos(20, 20);
@@ -29,9 +41,12 @@ void drawStatPanelTopLeft(sf::RenderTarget& target, const StatData& stats, const
     textY += lineHeight;
 
     // HP with bar
-    std::ostringstream hpStream;
-    hpStream << "HP: " << stats.currentHP << "/" << stats.maxHP;
-    text.setString(hpStream.str());
+    std::pmr::string line(&LinearArena::frame());
+    line += "HP: ";
+    appendInt(line, stats.currentHP);
+    line += '/';
+    appendInt(line, stats.maxHP);
+    text.setString(line.c_str());
     text.setPosition(panelPos.x + 8, textY);
     target.draw(text);
 
@@ -41,20 +56,24 @@ void drawStatPanelTopLeft(sf::RenderTarget& target, const StatData& stats, const
     textY += lineHeight + 8;
 
     // Attack & Defense
-    std::ostringstream atkDefStream;
-    atkDefStream << "ATK: " << stats.attack << " DEF: " << stats.defense;
-    text.setString(atkDefStream.str());
+    line = "ATK: ";
+    appendInt(line, stats.attack);
+    line += " DEF: ";
+    appendInt(line, stats.defense);
+    text.setString(line.c_str());
     text.setPosition(panelPos.x + 8, textY);
     target.draw(text);
     textY += lineHeight;
 
     // Status
-    text.setString("Status: " + stats.status);
+    line = "Status: ";
+    line += stats.status;
+    text.setString(line.c_str());
     text.setPosition(panelPos.x + 8, textY);
     target.draw(text);
 }
 
-void drawStatPanelBottomRight(sf::RenderTarget& target, const StatData& stats, const sf::Font& font,
+void drawStatPanelBottomRight(RenderList& target, const StatData& stats, const sf::Font& font,
                              sf::Vector2f windowSize, sf::Vector2f size) {
     // Use fixed position with 20px padding from bottom-right
     sf::Vector2f panelSize(280, 100); // Compact size
@@ -80,9 +99,12 @@ void drawStatPanelBottomRight(sf::RenderTarget& target, const StatData& stats, c
     textY += lineHeight;
 
     // HP with bar
-    std::ostringstream hpStream;
-    hpStream << "HP: " << stats.currentHP << "/" << stats.maxHP;
-    text.setString(hpStream.str());
+    std::pmr::string line(&LinearArena::frame());
+    line += "HP: ";
+    appendInt(line, stats.currentHP);
+    line += '/';
+    appendInt(line, stats.maxHP);
+    text.setString(line.c_str());
     text.setPosition(panelPos.x + 8, textY);
     target.draw(text);
 
@@ -92,20 +114,24 @@ void drawStatPanelBottomRight(sf::RenderTarget& target, const StatData& stats, c
     textY += lineHeight + 8;
 
     // Attack & Defense
-    std::ostringstream atkDefStream;
-    atkDefStream << "ATK: " << stats.attack << " DEF: " << stats.defense;
-    text.setString(atkDefStream.str());
+    line = "ATK: ";
+    appendInt(line, stats.attack);
+    line += " DEF: ";
+    appendInt(line, stats.defense);
+    text.setString(line.c_str());
     text.setPosition(panelPos.x + 8, textY);
     target.draw(text);
     textY += lineHeight;
 
     // Status
-    text.setString("Status: " + stats.status);
+    line = "Status: ";
+    line += stats.status;
+    text.setString(line.c_str());
     text.setPosition(panelPos.x + 8, textY);
     target.draw(text);
 }
 
-void drawBanner(sf::RenderTarget& target, const std::string& text, const sf::Font& font,
+void drawBanner(RenderList& target, const std::string& text, const sf::Font& font,
                sf::Vector2f windowSize, sf::Color textColor) {
     sf::Text bannerText;
     bannerText.setFont(font);
@@ -128,7 +154,7 @@ void drawBanner(sf::RenderTarget& target, const std::string& text, const sf::Fon
     target.draw(bannerText);
 }
 
-void drawHPBar(sf::RenderTarget& target, sf::Vector2f position, sf::Vector2f size,
+void drawHPBar(RenderList& target, sf::Vector2f position, sf::Vector2f size,
                int currentHP, int maxHP, sf::Color barColor) {
     // Background (black)
     sf::RectangleShape background;
@@ -150,7 +176,7 @@ void drawHPBar(sf::RenderTarget& target, sf::Vector2f position, sf::Vector2f siz
     }
 }
 
-void drawCoinChoice(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f windowSize) {
+void drawCoinChoice(RenderList& target, const sf::Font& font, sf::Vector2f windowSize) {
     sf::Text text;
     text.setFont(font);
     text.setString("Choose: HEAD or TAIL");
@@ -167,7 +193,7 @@ void drawCoinChoice(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f
     target.draw(text);
 }
 
-void drawCoinFlipping(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f windowSize) {
+void drawCoinFlipping(RenderList& target, const sf::Font& font, sf::Vector2f windowSize) {
     sf::Text text;
     text.setFont(font);
     text.setString("Flipping...");
@@ -184,10 +210,10 @@ void drawCoinFlipping(sf::RenderTarget& target, const sf::Font& font, sf::Vector
     target.draw(text);
 }
 
-void drawCoinResult(sf::RenderTarget& target, const sf::Font& font, sf::Vector2f windowSize,
+void drawCoinResult(RenderList& target, const sf::Font& font, sf::Vector2f windowSize,
                    bool isHead, bool correct) {
-    std::string resultText = "Result: " + std::string(isHead ? "HEAD" : "TAIL");
-    std::string statusText = correct ? "CORRECT! Special Attack!" : "WRONG! Normal Attack!";
+    const char* resultText = isHead ? "Result: HEAD" : "Result: TAIL";
+    const char* statusText = correct ? "CORRECT! Special Attack!" : "WRONG! Normal Attack!";
 
     sf::Text result;
     result.setFont(font);
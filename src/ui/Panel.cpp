@@ -1,4 +1,5 @@
 #include "ui/Panel.h"
+#include "core/RenderList.h"
 
 namespace UI {
 
@@ -35,7 +36,7 @@ void Panel::setOutlineThickness(float thickness) {
     m_shape.setOutlineThickness(thickness);
 }
 
-void Panel::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+void Panel::draw(RenderList& target, sf::RenderStates states) const {
     target.draw(m_shape, states);
 }
 
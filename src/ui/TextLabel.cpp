@@ -1,4 +1,5 @@
 #include "ui/TextLabel.h"
+#include "core/RenderList.h"
 
 namespace UI {
 
@@ -63,7 +64,7 @@ void TextLabel::setOrigin(const sf::Vector2f& origin) {
     m_text.setOrigin(origin);
 }
 
-void TextLabel::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+void TextLabel::draw(RenderList& target, sf::RenderStates states) const {
     target.draw(m_text, states);
 }
 
@@ -1,10 +1,11 @@
 #include "world/Map.h"
+#include "core/RenderList.h"
+#include "core/Profiler.h"
 #include "entities/Player.h"
 #include "core/RNG.h"
 #include "core/AssetManager.h"
 #include "Constants.h"
 #include <fstream>
-#include <queue>
 #include <iostream>
 #include <optional>
 
@@ -13,6 +14,9 @@ Map::Map()
     , m_height(Constants::MAP_HEIGHT)
     , m_startPos(Constants::START_X, Constants::START_Y)
     , m_goalPos(Constants::GOAL_X, Constants::GOAL_Y)
+    , m_scratch(Constants::MAP_SCRATCH_ARENA_SIZE)
+    , m_revision(0)
+    , m_floorRevision(0)
 {
     m_tileShape.setSize(sf::Vector2f(Constants::TILE_SIZE, Constants::TILE_SIZE));
     initializeTiles();
@@ -25,6 +29,7 @@ void Map::generateMaze(RNG& rng, unsigned int seed) {
     if (seed != 0) {
         rng.setSeed(seed);
     }
+    m_scratch.reset();
 
     // Clear previous data
     m_rocks.clear();
@@ -47,6 +52,7 @@ void Map::generateMap(RNG& rng, unsigned int seed) {
 }
 void Map::generateZigZag(RNG& rng, unsigned int seed) {
     if (seed != 0) rng.setSeed(seed);
+    m_scratch.reset();
 
     // Clear previous data
     m_rocks.clear();
@@ -98,7 +104,8 @@ void Map::generateZigZag(RNG& rng, unsigned int seed) {
 
 void Map::placeGameElements(RNG& rng, const std::vector<Vec2i>& pathCells) {
     // Exclude start and goal from placement
-    std::vector<Vec2i> availableCells;
+    std::pmr::vector<Vec2i> availableCells(&m_scratch);
+    availableCells.reserve(pathCells.size());
     for (const auto& cell : pathCells) {
         if (cell != m_startPos && cell != m_goalPos) {
             availableCells.push_back(cell);
@@ -275,6 +282,7 @@ bool Map::loadFromCSV(const std::string& filename) {
         }
         y++;
     }
+    ++m_revision;
 
     return true;
 }
@@ -310,6 +318,7 @@ TileType Map::getTileType(const Vec2i& pos) const {
 void Map::setTileType(int x, int y, TileType type) {
     if (isValidPosition(x, y)) {
         m_tiles[y][x].setType(type);
+        ++m_revision;
     }
 }
 
@@ -337,18 +346,21 @@ bool Map::isWalkable(const Vec2i& pos) const {
 }
 
 bool Map::hasValidPath(const Vec2i& start, const Vec2i& goal) const {
-    // Simple BFS pathfinding
-    std::queue<Vec2i> queue;
-    std::vector<std::vector<bool>> visited(m_height, std::vector<bool>(m_width, false));
+    // Simple BFS pathfinding; a flat visited grid and a vector queue, both
+    // in the frame arena since they die with the call
+    LinearArena& arena = LinearArena::frame();
+    std::pmr::vector<char> visited(static_cast<std::size_t>(m_width) * m_height, 0, &arena);
+    std::pmr::vector<Vec2i> queue(&arena);
+    queue.reserve(visited.size());
+    std::size_t head = 0;
 
-    queue.push(start);
-    visited[start.y][start.x] = true;
+    queue.push_back(start);
+    visited[start.y * m_width + start.x] = 1;
 
     Vec2i directions[] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
 
-    while (!queue.empty()) {
-        Vec2i current = queue.front();
-        queue.pop();
+    while (head < queue.size()) {
+        Vec2i current = queue[head++];
 
         if (current == goal) {
             return true;
@@ -357,9 +369,9 @@ bool Map::hasValidPath(const Vec2i& start, const Vec2i& goal) const {
         for (const auto& dir : directions) {
             Vec2i next = current + dir;
 
-            if (isValidPosition(next) && !visited[next.y][next.x] && isWalkable(next)) {
-                visited[next.y][next.x] = true;
-                queue.push(next);
+            if (isValidPosition(next) && !visited[next.y * m_width + next.x] && isWalkable(next)) {
+                visited[next.y * m_width + next.x] = 1;
+                queue.push_back(next);
             }
         }
     }
@@ -385,7 +397,7 @@ Vec2i Map::getRandomWalkablePosition(RNG& rng) const {
     return pos;
 }
 
-void Map::draw(sf::RenderTarget& target, const sf::View& view) const {
+void Map::draw(RenderList& target, const sf::View& view) const {
     // Get view bounds for culling
     sf::FloatRect viewBounds(
         view.getCenter().x - view.getSize().x / 2.0f,
@@ -412,7 +424,8 @@ void Map::draw(sf::RenderTarget& target, const sf::View& view) const {
         }
     }
 }
-void Map::drawWithSprites(sf::RenderTarget& target, const sf::View& view, const AssetManager& assets) const {
+void Map::drawWithSprites(RenderList& target, const sf::View& view, const AssetManager& assets) const {
+    PROFILE_SCOPE("Map::drawWithSprites");
     // Get view bounds for culling
     sf::FloatRect viewBounds(
         view.getCenter().x - view.getSize().x / 2.0f,
@@ -423,38 +436,12 @@ void Map::drawWithSprites(sf::RenderTarget& target, const sf::View& view, const
 
     // Z-order rendering: floor/background → portal/rock → monsters → player → viền trắng → UI overlay
 
-    // 1. Draw floor/background
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            sf::Vector2f tilePos(x * Constants::TILE_SIZE, y * Constants::TILE_SIZE);
-
-            // Simple culling
-            if (tilePos.x + Constants::TILE_SIZE < viewBounds.left ||
-                tilePos.x > viewBounds.left + viewBounds.width ||
-                tilePos.y + Constants::TILE_SIZE < viewBounds.top ||
-                tilePos.y > viewBounds.top + viewBounds.height) {
-                continue;
-            }
-
-            Vec2i pos(x, y);
-            TileType type = getTileType(pos);
-
-            // Draw background tile
-            m_tileShape.setPosition(tilePos);
-            m_tileShape.setSize(sf::Vector2f(Constants::TILE_SIZE, Constants::TILE_SIZE));
-
-            if (type == TileType::Wall) {
-                m_tileShape.setFillColor(sf::Color::Black);
-                m_tileShape.setOutlineThickness(1.0f);
-                m_tileShape.setOutlineColor(sf::Color::White);
-            } else {
-                m_tileShape.setFillColor(sf::Color(30, 30, 30)); // Dark gray for walkable
-                m_tileShape.setOutlineThickness(0.0f);
-            }
-
-            target.draw(m_tileShape);
-        }
+    // 1. Draw floor/background: one cached vertex array, rebuilt only when a
+    // tile changes. It is shared, not copied, into recorded render snapshots.
+    if (!m_floorLayer || m_floorRevision != m_revision) {
+        rebuildFloorLayer();
     }
+    target.draw(m_floorLayer);
 
     // 2. Draw portal/rock sprites
     for (int y = 0; y < m_height; ++y) {
@@ -536,24 +523,65 @@ void Map::drawWithSprites(sf::RenderTarget& target, const sf::View& view, const
     }
 }
 
-void Map::drawVisitedTiles(sf::RenderTarget& target, const Player& player) const {
-    // Draw semi-transparent overlay on visited tiles
-    sf::RectangleShape visitedOverlay;
-    visitedOverlay.setSize(sf::Vector2f(Constants::TILE_SIZE, Constants::TILE_SIZE));
-    visitedOverlay.setFillColor(sf::Color(100, 100, 100, 80)); // Gray with transparency
+void Map::drawVisitedTiles(RenderList& target, const Player& player) const {
+    // Draw semi-transparent overlay on visited tiles, batched into one draw
+    sf::VertexArray visitedOverlay(sf::Triangles);
+    const sf::Color overlayColor(100, 100, 100, 80); // Gray with transparency
 
     for (int y = 0; y < m_height; ++y) {
         for (int x = 0; x < m_width; ++x) {
             Vec2i pos(x, y);
             if (player.hasVisited(pos)) {
-                visitedOverlay.setPosition(x * Constants::TILE_SIZE, y * Constants::TILE_SIZE);
-                target.draw(visitedOverlay);
+                appendQuad(visitedOverlay,
+                           sf::FloatRect(x * Constants::TILE_SIZE, y * Constants::TILE_SIZE, Constants::TILE_SIZE, Constants::TILE_SIZE),
+                           overlayColor);
+            }
+        }
+    }
+
+    if (visitedOverlay.getVertexCount() > 0) {
+        target.draw(visitedOverlay);
+    }
+}
+
+void Map::rebuildFloorLayer() const {
+    auto floor = std::make_shared<sf::VertexArray>(sf::Triangles);
+    const float size = Constants::TILE_SIZE;
+
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            sf::FloatRect tile(x * size, y * size, size, size);
+
+            if (getTileType(Vec2i(x, y)) == TileType::Wall) {
+                // 1px white outline around a black tile, drawn outside the tile
+                // like sf::Shape outlines so later tiles still cover it
+                appendQuad(*floor, sf::FloatRect(tile.left - 1.0f, tile.top - 1.0f, size + 2.0f, size + 2.0f), sf::Color::White);
+                appendQuad(*floor, tile, sf::Color::Black);
+            } else {
+                appendQuad(*floor, tile, sf::Color(30, 30, 30)); // Dark gray for walkable
             }
         }
     }
+
+    m_floorLayer = floor;
+    m_floorRevision = m_revision;
 }
 
-void Map::drawPlayer(sf::RenderTarget& target, const Vec2i& playerPos, const AssetManager& assets) const {
+void Map::appendQuad(sf::VertexArray& vertices, const sf::FloatRect& rect, const sf::Color& color) {
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+
+    vertices.append(sf::Vertex(topLeft, color));
+    vertices.append(sf::Vertex(topRight, color));
+    vertices.append(sf::Vertex(bottomRight, color));
+    vertices.append(sf::Vertex(topLeft, color));
+    vertices.append(sf::Vertex(bottomRight, color));
+    vertices.append(sf::Vertex(bottomLeft, color));
+}
+
+void Map::drawPlayer(RenderList& target, const Vec2i& playerPos, const AssetManager& assets) const {
     // Draw player sprite on top of everything
     sf::Sprite playerSprite = assets.makeSprite("player_map", Constants::TILE_SIZE - 2, Constants::TILE_SIZE - 2);
     playerSprite.setPosition(playerPos.x * Constants::TILE_SIZE + 1, playerPos.y * Constants::TILE_SIZE + 1);
@@ -568,6 +596,7 @@ void Map::initializeTiles() {
             m_tiles[y][x].setType(TileType::Empty);
         }
     }
+    ++m_revision;
 }
 
 void Map::placeMandatoryTiles() {
@@ -682,11 +711,11 @@ static inline bool insideInterior(const Vec2i& p, int w, int h) {
 
 void Map::createMazePath(RNG& rng) {
     // Depth-first backtracker on grid with bias towards goal
-    std::vector<std::vector<bool>> visited(m_height, std::vector<bool>(m_width, false));
+    std::pmr::vector<char> visited(static_cast<std::size_t>(m_width) * m_height, 0, &m_scratch);
     std::vector<Vec2i> stack;
 
     auto canCarve = [&](const Vec2i& next) {
-        if (!insideInterior(next, m_width, m_height) || visited[next.y][next.x]) return false;
+        if (!insideInterior(next, m_width, m_height) || visited[next.y * m_width + next.x]) return false;
         // Avoid over-wide openings
         int adjEmpty = 0;
         Vec2i dirs[4] = { {1,0},{-1,0},{0,1},{0,-1} };
@@ -701,7 +730,7 @@ void Map::createMazePath(RNG& rng) {
     Vec2i goal  = m_goalPos;
 
     stack.push_back(start);
-    visited[start.y][start.x] = true;
+    visited[start.y * m_width + start.x] = 1;
     setTileType(start, TileType::Empty);
 
     while (!stack.empty()) {
@@ -727,7 +756,7 @@ void Map::createMazePath(RNG& rng) {
             std::sort(scored.begin(), scored.end(), [](auto& a, auto& b){ return a.first < b.first; });
             Vec2i next = scored[0].second;
             if (scored.size() > 1 && rng.rollRange(1, 100) <= 35) next = scored[1].second;
-            visited[next.y][next.x] = true;
+            visited[next.y * m_width + next.x] = 1;
             setTileType(next, TileType::Empty);
             stack.push_back(next);
         } else {
@@ -780,19 +809,26 @@ void Map::createRandomBranch(RNG& rng, Vec2i start, int length) {
     }
 }
 
-void Map::placeMonsters(RNG& rng) {
-    m_monsterPositions.clear();
-
-    // Find empty positions on the path
-    std::vector<Vec2i> emptyPositions;
+std::pmr::vector<Vec2i> Map::collectEmptyPositions() {
+    // Sized once up front: the arena never reuses what a growing vector leaves behind
+    std::pmr::vector<Vec2i> positions(&m_scratch);
+    positions.reserve(static_cast<std::size_t>(m_width) * m_height);
     for (int y = 0; y < m_height; ++y) {
         for (int x = 0; x < m_width; ++x) {
             Vec2i pos(x, y);
             if (getTileType(pos) == TileType::Empty && pos != m_startPos && pos != m_goalPos) {
-                emptyPositions.push_back(pos);
+                positions.push_back(pos);
             }
         }
     }
+    return positions;
+}
+
+void Map::placeMonsters(RNG& rng) {
+    m_monsterPositions.clear();
+
+    // Find empty positions on the path
+    std::pmr::vector<Vec2i> emptyPositions = collectEmptyPositions();
 
     // Place 2 normal monsters
     for (int i = 0; i < Constants::NORMAL_MONSTERS && !emptyPositions.empty(); ++i) {
@@ -811,15 +847,7 @@ void Map::placeRocks(RNG& rng) {
     m_rocks.clear();
 
     // Find empty positions on the path
-    std::vector<Vec2i> emptyPositions;
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            Vec2i pos(x, y);
-            if (getTileType(pos) == TileType::Empty && pos != m_startPos && pos != m_goalPos) {
-                emptyPositions.push_back(pos);
-            }
-        }
-    }
+    std::pmr::vector<Vec2i> emptyPositions = collectEmptyPositions();
 
     // Place up to MAX_ROCKS_ON_PATH rocks
     int rocksToPlace = std::min(Constants::MAX_ROCKS_ON_PATH, static_cast<int>(emptyPositions.size()));
@@ -836,15 +864,7 @@ void Map::setupTeleportGates(RNG& rng) {
     m_teleportGates.clear();
 
     // Find empty positions on the path
-    std::vector<Vec2i> emptyPositions;
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            Vec2i pos(x, y);
-            if (getTileType(pos) == TileType::Empty && pos != m_startPos && pos != m_goalPos) {
-                emptyPositions.push_back(pos);
-            }
-        }
-    }
+    std::pmr::vector<Vec2i> emptyPositions = collectEmptyPositions();
 
     // Place teleport gate pairs
     for (int pairId = 0; pairId < Constants::TELEPORT_GATE_PAIRS && emptyPositions.size() >= 2; ++pairId) {
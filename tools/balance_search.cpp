@@ -0,0 +1,437 @@
+// Balance search: tunes the encounter constants toward target win rates and
+// turns to win. Each round simulates a batch of battles for the current
+// values and for every tuned constant one step up and one step down, all in
+// parallel and on the same random streams, then moves to the best of them;
+// when none beats the current values the steps are halved (grid refinement).
+// Prints the suggested constants with their metrics, in a form --params reads
+// back. Build with -DBUILD_BENCHMARKS=ON and run ./balance_search from the
+// build directory.
+#include "core/CombatEngine.h"
+#include "core/FastRNG.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Action = CombatEngine::Action;
+    using Encounter = CombatEngine::Encounter;
+    using Stats = CombatEngine::EncounterStats;
+
+    // A battle that has not ended by then counts as lost
+    const int MaxSteps = 1000;
+    // Random streams per evaluation. Every candidate plays the same ones, so
+    // the difference between two candidates is theirs, not the draw's
+    const std::size_t ChunkCount = 64;
+    // 95% two-sided
+    const double Z = 1.96;
+
+    // A miss of 2 points of win rate weighs as much as one of half a turn
+    const double WinTolerance = 0.02;
+    const double TurnTolerance = 0.5;
+    // Mean turns to win charged when no battle was won
+    const double NoWinTurns = 100.0;
+
+    constexpr std::size_t EncounterCount = 3;
+    const char* const EncounterNames[EncounterCount] = {"chalamander", "bisasam", "boss"};
+
+    // A constant the search works on, by its name in Constants.h
+    struct Parameter {
+        const char* name;
+        int Stats::* field;
+        int min;
+        int max;
+        bool tuned;         // False for stats these battles never read
+    };
+
+    // Bisasam fights with 2 ATK and 5 MP less than the base enemy
+    const Parameter Parameters[] = {
+        {"BASE_ENEMY_HP", &Stats::enemyHp, 10, 500, true},
+        {"BASE_ENEMY_MP", &Stats::enemyMp, 5, 200, false},
+        {"BASE_ENEMY_ATK", &Stats::enemyAtk, 3, 99, true},
+        {"BASE_ENEMY_DEF", &Stats::enemyDef, 0, 99, false},
+        {"BASE_BOSS_HP", &Stats::bossHp, 10, 1000, true},
+        {"BASE_BOSS_MP", &Stats::bossMp, 0, 200, false},
+        {"BASE_BOSS_ATK", &Stats::bossAtk, 1, 99, true},
+        {"BASE_BOSS_DEF", &Stats::bossDef, 0, 99, false}
+    };
+    constexpr std::size_t ParameterCount = sizeof(Parameters) / sizeof(Parameters[0]);
+
+    struct Target {
+        double winRate;
+        double turns;       // Mean coin calls to win
+    };
+
+    struct Tally {
+        std::uint64_t battles = 0;
+        std::uint64_t victories = 0;
+        double turnSum = 0.0, turnSquares = 0.0;
+
+        void merge(const Tally& other) {
+            battles += other.battles;
+            victories += other.victories;
+            turnSum += other.turnSum;
+            turnSquares += other.turnSquares;
+        }
+
+        double winRate() const { return battles > 0 ? static_cast<double>(victories) / battles : 0.0; }
+        double turns() const { return victories > 0 ? turnSum / victories : NoWinTurns; }
+    };
+
+    using Tallies = std::array<Tally, EncounterCount>;
+
+    // The simulated player: random coin calls and a random choice whenever a
+    // skill menu opens, winrate_sim's default policy
+    Action chooseAction(const CombatEngine::State& state, FastRNG& rng) {
+        if (state.phase == CombatEngine::Phase::CoinChoice) {
+            return rng.rollRange(0, 1) == 0 ? Action::CallHead : Action::CallTail;
+        }
+        if (!state.skillMenu) {
+            return Action::Attack;
+        }
+        if (state.defending) {
+            return static_cast<Action>(static_cast<int>(Action::Skill1) + rng.rollRange(0, 2));
+        }
+        int pick = rng.rollRange(0, 3);
+        return pick == 0 ? Action::Attack : static_cast<Action>(static_cast<int>(Action::Skill1) + pick - 1);
+    }
+
+    void runBattle(CombatEngine& engine, const CombatEngine::State& start, FastRNG& rng, Tally& tally) {
+        engine.reset(start);
+
+        int steps = 0;
+        int turns = 0;
+        while (!engine.isOver() && steps < MaxSteps) {
+            Action action = chooseAction(engine.getState(), rng);
+            turns += action == Action::CallHead || action == Action::CallTail;
+            engine.step(action, rng);
+            ++steps;
+        }
+
+        ++tally.battles;
+        if (engine.getState().phase != CombatEngine::Phase::Victory) return;
+        ++tally.victories;
+        tally.turnSum += turns;
+        tally.turnSquares += static_cast<double>(turns) * turns;
+    }
+
+    // Squared misses in units of the tolerances, summed over the targeted encounters
+    double loss(const Tallies& tallies, const std::vector<Encounter>& encounters,
+                const std::array<Target, EncounterCount>& targets) {
+        double total = 0.0;
+        for (Encounter encounter : encounters) {
+            std::size_t index = static_cast<std::size_t>(encounter);
+            double win = (tallies[index].winRate() - targets[index].winRate) / WinTolerance;
+            double turns = (tallies[index].turns() - targets[index].turns) / TurnTolerance;
+            total += win * win + turns * turns;
+        }
+        return total;
+    }
+
+    // One work item per candidate, encounter and stream, merged per candidate
+    // and encounter once all are done
+    std::vector<Tallies> evaluate(JobSystem& jobs, bool serial, const std::vector<Stats>& candidates,
+                                  const std::vector<Encounter>& encounters, const std::vector<FastRNG>& streams,
+                                  std::uint64_t battles) {
+        const std::size_t chunks = streams.size();
+        const std::size_t perCandidate = encounters.size() * chunks;
+        std::vector<Tally> tallies(candidates.size() * perCandidate);
+
+        auto body = [&](std::size_t begin, std::size_t end) {
+            CombatEngine engine;
+            for (std::size_t item = begin; item < end; ++item) {
+                std::size_t chunk = item % chunks;
+                Encounter encounter = encounters[(item / chunks) % encounters.size()];
+                const CombatEngine::State start =
+                    CombatEngine::makeEncounterState(encounter, candidates[item / perCandidate]);
+
+                FastRNG rng = streams[chunk];
+                std::uint64_t count = battles / chunks + (chunk < battles % chunks ? 1 : 0);
+                for (std::uint64_t i = 0; i < count; ++i) {
+                    runBattle(engine, start, rng, tallies[item]);
+                }
+            }
+        };
+        if (serial) {
+            body(0, tallies.size());
+        } else {
+            jobs.parallelFor(tallies.size(), 1, body);
+        }
+
+        std::vector<Tallies> results(candidates.size());
+        for (std::size_t item = 0; item < tallies.size(); ++item) {
+            std::size_t encounter = static_cast<std::size_t>(encounters[(item / chunks) % encounters.size()]);
+            results[item / perCandidate][encounter].merge(tallies[item]);
+        }
+        return results;
+    }
+
+    // Stream k is the seed's generator jumped k times: 2^128 draws apart
+    std::vector<FastRNG> makeStreams(std::uint64_t seed, std::uint64_t battles) {
+        std::vector<FastRNG> streams;
+        FastRNG stream(seed);
+        for (std::size_t i = 0; i < std::min<std::uint64_t>(ChunkCount, battles); ++i) {
+            streams.push_back(stream);
+            stream.jump();
+        }
+        return streams;
+    }
+
+    // The whole value as a decimal number; std::stoull would throw on "abc"
+    template <typename T>
+    bool parseNumber(const std::string& value, T& out) {
+        const char* end = value.data() + value.size();
+        auto [last, error] = std::from_chars(value.data(), end, out);
+        return error == std::errc() && last == end;
+    }
+
+    // "NAME = value" per line, as printed at the end of a search; a C++
+    // declaration of the constant reads too. # and // start comments
+    bool loadParams(const std::string& filename, Stats& stats) {
+        std::ifstream file(filename);
+        if (!file) {
+            std::cerr << "Cannot open " << filename << std::endl;
+            return false;
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            line = line.substr(0, std::min(line.find('#'), line.find("//")));
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            // The name is the last word before the '='
+            std::size_t equals = line.find('=');
+            std::istringstream words(line.substr(0, equals));
+            std::string name;
+            for (std::string word; words >> word;) name = word;
+
+            const Parameter* parameter = nullptr;
+            for (const Parameter& candidate : Parameters) {
+                if (name == candidate.name) parameter = &candidate;
+            }
+
+            char* end = nullptr;
+            long value = equals == std::string::npos ? 0 : std::strtol(line.c_str() + equals + 1, &end, 10);
+            bool parsed = end != nullptr && end != line.c_str() + equals + 1
+                       && std::string(end).find_first_not_of(" \t\r;") == std::string::npos;
+            if (!parameter || !parsed) {
+                std::cerr << filename << ":" << lineNumber << ": expected NAME = value with NAME one of the "
+                          << "BASE_ENEMY_* / BASE_BOSS_* stats" << std::endl;
+                return false;
+            }
+            if (value < parameter->min || value > parameter->max) {
+                std::cerr << filename << ":" << lineNumber << ": " << name << " must be in ["
+                          << parameter->min << ", " << parameter->max << "]" << std::endl;
+                return false;
+            }
+            stats.*parameter->field = static_cast<int>(value);
+        }
+        return true;
+    }
+
+    // "boss=50,8": win rate in percent, then mean turns to win
+    bool parseTarget(const std::string& value, std::array<Target, EncounterCount>& targets) {
+        std::size_t equals = value.find('=');
+        std::size_t comma = value.find(',', equals);
+        if (equals == std::string::npos || comma == std::string::npos) return false;
+
+        std::string name = value.substr(0, equals);
+        for (std::size_t i = 0; i < EncounterCount; ++i) {
+            if (name != EncounterNames[i]) continue;
+
+            char* end = nullptr;
+            double win = std::strtod(value.c_str() + equals + 1, &end);
+            if (end != value.c_str() + comma || win <= 0.0 || win > 100.0) return false;
+            double turns = std::strtod(value.c_str() + comma + 1, &end);
+            if (*end != '\0' || turns <= 0.0) return false;
+
+            targets[i] = Target{win / 100.0, turns};
+            return true;
+        }
+        return false;
+    }
+
+    void printStats(const Stats& stats, const Stats* previous) {
+        for (const Parameter& parameter : Parameters) {
+            if (!parameter.tuned) continue;
+            int value = stats.*parameter.field;
+            if (previous && previous->*parameter.field == value) continue;
+            std::printf("  %s %d", parameter.name, value);
+        }
+    }
+
+    void printMetrics(const char* label, const Tally& tally) {
+        double p = tally.winRate();
+        double n = static_cast<double>(tally.battles);
+        double spread = n > 0 ? Z * std::sqrt(p * (1.0 - p) / n) : 0.0;
+        double variance = tally.victories > 1
+            ? (tally.turnSquares - tally.turnSum * tally.turns()) / (tally.victories - 1) : 0.0;
+        double turnSpread = tally.victories > 1 ? Z * std::sqrt(std::max(variance, 0.0) / tally.victories) : 0.0;
+        std::printf("    %-10s %6.2f%% +/- %4.2f   %6.2f +/- %4.2f turns\n", label, 100.0 * p, 100.0 * spread,
+                    tally.turns(), turnSpread);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* usage = " [--target chalamander|bisasam|boss=WIN%,TURNS]... [--params FILE] [--battles N]"
+                        " [--rounds N] [--check N] [--seed S] [--threads T]";
+
+    std::array<Target, EncounterCount> targets = {{{0.80, 5.0}, {0.80, 5.0}, {0.50, 8.0}}};
+    std::vector<Encounter> encounters = {Encounter::Chalamander, Encounter::Bisasam, Encounter::Boss};
+    Stats start;
+    std::uint64_t battles = 20000;
+    std::uint64_t check = 1000000;
+    int rounds = 100;
+    std::uint64_t seed = 42;
+    std::size_t threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << usage << std::endl;
+            return 0;
+        }
+        else if (arg == "--target" && i + 1 < argc) {
+            ok = parseTarget(argv[++i], targets);
+        }
+        else if (arg == "--params" && i + 1 < argc) {
+            if (!loadParams(argv[++i], start)) return 1;
+        }
+        else if (arg == "--battles" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], battles);
+        }
+        else if (arg == "--check" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], check);
+        }
+        else if (arg == "--rounds" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], rounds);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], seed);
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], threads);
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok || battles == 0 || check == 0) {
+            std::cerr << "Bad argument: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0] << usage << std::endl;
+            return 1;
+        }
+    }
+
+    // The calling thread works too, so one worker fewer than requested;
+    // --threads 1 keeps everything on the calling thread
+    const bool serial = threads == 1;
+    JobSystem jobs(threads > 1 ? threads - 1 : (serial ? 1 : 0));
+    std::size_t workers = serial ? 1 : jobs.getWorkerCount() + 1;
+
+    std::printf("Balance search: %llu battles per encounter and candidate, seed %llu, %zu threads\n",
+                static_cast<unsigned long long>(battles), static_cast<unsigned long long>(seed), workers);
+    std::printf("Targets (random player):");
+    for (std::size_t i = 0; i < EncounterCount; ++i) {
+        std::printf("  %s %.1f%% in %.2f turns", EncounterNames[i], 100.0 * targets[i].winRate, targets[i].turns);
+    }
+    std::printf("\nStart:");
+    printStats(start, nullptr);
+    std::printf("\n");
+
+    auto begin = Clock::now();
+    const std::vector<FastRNG> streams = makeStreams(seed, battles);
+
+    std::array<int, ParameterCount> steps{};
+    for (std::size_t i = 0; i < ParameterCount; ++i) {
+        if (Parameters[i].tuned) steps[i] = std::max(1, start.*Parameters[i].field / 8);
+    }
+
+    Stats current = start;
+    double currentLoss = loss(evaluate(jobs, serial, {current}, encounters, streams, battles)[0], encounters, targets);
+    std::printf("  round  0  loss %10.3f\n", currentLoss);
+
+    for (int round = 1; round <= rounds; ++round) {
+        std::vector<Stats> candidates;
+        for (std::size_t i = 0; i < ParameterCount; ++i) {
+            if (steps[i] == 0) continue;
+            const Parameter& parameter = Parameters[i];
+            for (int direction : {-1, 1}) {
+                Stats candidate = current;
+                int& value = candidate.*parameter.field;
+                value = std::clamp(value + direction * steps[i], parameter.min, parameter.max);
+                if (value != current.*parameter.field) candidates.push_back(candidate);
+            }
+        }
+
+        std::vector<Tallies> results = evaluate(jobs, serial, candidates, encounters, streams, battles);
+        std::size_t best = candidates.size();
+        double bestLoss = currentLoss;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            double candidateLoss = loss(results[i], encounters, targets);
+            if (candidateLoss < bestLoss) {
+                best = i;
+                bestLoss = candidateLoss;
+            }
+        }
+
+        if (best < candidates.size()) {
+            std::printf("  round %2d  loss %10.3f ", round, bestLoss);
+            printStats(candidates[best], &current);
+            std::printf("\n");
+            current = candidates[best];
+            currentLoss = bestLoss;
+            continue;
+        }
+
+        // Nothing nearby is better: look closer, or stop at steps of 1
+        bool finest = true;
+        for (int& step : steps) {
+            if (step > 1) finest = false;
+            if (step > 0) step = std::max(1, step / 2);
+        }
+        if (finest) break;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    std::printf("Search done in %.1f s\n", seconds);
+
+    // Measured again on other streams, so the numbers are not the ones the
+    // search fitted
+    std::vector<Tallies> checked = evaluate(jobs, serial, {start, current}, encounters,
+                                            makeStreams(seed + 1, check), check);
+    std::printf("\nMetrics over %llu battles per encounter (95%% CI):\n", static_cast<unsigned long long>(check));
+    for (Encounter encounter : encounters) {
+        std::size_t index = static_cast<std::size_t>(encounter);
+        std::printf("  %s (target %.1f%% in %.2f turns)\n", EncounterNames[index],
+                    100.0 * targets[index].winRate, targets[index].turns);
+        printMetrics("start", checked[0][index]);
+        printMetrics("suggested", checked[1][index]);
+    }
+
+    std::printf("\nSuggested constants (Constants.h; --params reads this back):\n");
+    for (const Parameter& parameter : Parameters) {
+        std::printf("    constexpr int %s = %d;%s\n", parameter.name, current.*parameter.field,
+                    parameter.tuned ? "" : "    // Not tuned");
+    }
+    std::printf("Not tuned: DEF is not read by the combat rules, MP only pays for boss moves, which these\n"
+                "battles do not play, and BOSS_DAMAGE_REDUCTION and the level-up bonuses change entity\n"
+                "stats the combat engine does not use.\n"
+                "The game starts its battles from these constants, but its boss also picks Power Strike and\n"
+                "Guard by search: the boss metrics are for a boss that only attacks and likely overstate the\n"
+                "player's chances against the game's.\n");
+    return 0;
+}
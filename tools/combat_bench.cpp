@@ -0,0 +1,86 @@
+// Combat engine benchmark: whole battles per second on one core, with a
+// random player picking among the actions that apply at each step.
+// Build with -DBUILD_BENCHMARKS=ON and run ./combat_bench from the build directory.
+#include "core/CombatEngine.h"
+#include "core/FastRNG.h"
+#include "core/RNG.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // A battle that has not ended by then is counted as stalled
+    const int MaxSteps = 1000;
+
+    struct Totals {
+        std::uint64_t battles = 0;
+        std::uint64_t victories = 0;
+        std::uint64_t steps = 0;
+        std::uint64_t stalled = 0;
+    };
+
+    template <typename Rng>
+    void runBattle(CombatEngine& engine, Rng& rng, Totals& totals) {
+        using Action = CombatEngine::Action;
+        engine.reset();
+
+        int steps = 0;
+        while (!engine.isOver() && steps < MaxSteps) {
+            const CombatEngine::State& state = engine.getState();
+            Action action;
+            if (state.phase == CombatEngine::Phase::CoinChoice) {
+                action = rng.rollRange(0, 1) == 0 ? Action::CallHead : Action::CallTail;
+            } else if (state.skillMenu) {
+                // Strike or one of the three skills
+                int pick = rng.rollRange(0, 3);
+                action = pick == 0 ? Action::Attack : static_cast<Action>(static_cast<int>(Action::Skill1) + pick - 1);
+            } else {
+                action = Action::Attack;
+            }
+            engine.step(action, rng);
+            ++steps;
+        }
+
+        ++totals.battles;
+        totals.steps += steps;
+        totals.victories += engine.getState().phase == CombatEngine::Phase::Victory;
+        totals.stalled += !engine.isOver();
+    }
+
+    template <typename Rng>
+    void bench(const char* name, Rng& rng, std::uint64_t battles) {
+        CombatEngine engine;
+        Totals totals;
+
+        auto start = Clock::now();
+        for (std::uint64_t i = 0; i < battles; ++i) {
+            runBattle(engine, rng, totals);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::printf("  %-8s %10llu battles  %7.2f M battles/s  %6.1f ns/step  %5.1f steps/battle  %5.1f%% won",
+                    name, static_cast<unsigned long long>(totals.battles),
+                    totals.battles / seconds / 1e6, seconds * 1e9 / totals.steps,
+                    static_cast<double>(totals.steps) / totals.battles,
+                    100.0 * totals.victories / totals.battles);
+        if (totals.stalled > 0) {
+            std::printf("  (%llu stalled)", static_cast<unsigned long long>(totals.stalled));
+        }
+        std::printf("\n");
+    }
+}
+
+int main() {
+    const std::uint64_t battles = 5000000;
+    std::printf("Combat engine benchmark (single thread, random player)\n");
+
+    FastRNG fast(42);
+    bench("FastRNG", fast, battles);
+
+    // The game's generator, for scale: mt19937 behind uniform_int_distribution
+    RNG game(42);
+    bench("RNG", game, battles / 5);
+    return 0;
+}
@@ -0,0 +1,125 @@
+// Job system micro-benchmarks: scheduling overhead and parallel_for scaling.
+// Build with -DBUILD_BENCHMARKS=ON and run ./job_bench from the build directory.
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Independent empty jobs submitted from the main thread, then waited on
+    void benchScheduleOverhead(JobSystem& jobs) {
+        const std::size_t count = 200000;
+        std::vector<JobSystem::JobHandle> handles;
+        handles.reserve(count);
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            handles.push_back(jobs.schedule([]() {}));
+        }
+        jobs.wait(handles);
+        double seconds = secondsSince(start);
+
+        std::printf("  schedule+wait  %8zu empty jobs    %8.1f ns/job\n", count, seconds * 1e9 / count);
+    }
+
+    // Serial chain: every job depends on the previous one, so this is pure
+    // dependency-resolution latency
+    void benchDependencyChain(JobSystem& jobs) {
+        const std::size_t count = 50000;
+
+        auto start = Clock::now();
+        JobSystem::JobHandle previous;
+        for (std::size_t i = 0; i < count; ++i) {
+            previous = jobs.schedule([]() {}, {previous});
+        }
+        jobs.wait(previous);
+        double seconds = secondsSince(start);
+
+        std::printf("  dependency chain %6zu jobs          %8.1f ns/job\n", count, seconds * 1e9 / count);
+    }
+
+    // Main thread -> worker -> main thread round trip through asyncThen
+    void benchMainThreadContinuation(JobSystem& jobs) {
+        const std::size_t count = 20000;
+        std::size_t completed = 0;
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            jobs.asyncThen([i]() { return i; }, [&completed](std::size_t) { ++completed; });
+        }
+        while (completed < count) {
+            if (jobs.pumpMainThread() == 0) {
+                std::this_thread::yield();
+            }
+        }
+        double seconds = secondsSince(start);
+
+        std::printf("  asyncThen round trip %6zu          %8.1f ns/job\n", count, seconds * 1e9 / count);
+    }
+
+    double workload(std::size_t begin, std::size_t end) {
+        double sum = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            sum += std::sqrt(static_cast<double>(i)) * std::sin(static_cast<double>(i));
+        }
+        return sum;
+    }
+
+    double runParallelFor(JobSystem& jobs, std::size_t count, std::size_t grain) {
+        std::size_t chunks = (count + grain - 1) / grain;
+        std::vector<double> partial(chunks, 0.0);
+
+        auto start = Clock::now();
+        jobs.parallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+            partial[begin / grain] = workload(begin, end);
+        });
+        double seconds = secondsSince(start);
+
+        volatile double sink = 0.0;
+        for (double value : partial) sink = sink + value;
+        return seconds;
+    }
+}
+
+int main() {
+    unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("Job system benchmark (%u hardware threads)\n\n", hardware);
+
+    {
+        JobSystem jobs;
+        std::printf("Scheduling overhead (%zu workers)\n", jobs.getWorkerCount());
+        benchScheduleOverhead(jobs);
+        benchDependencyChain(jobs);
+        benchMainThreadContinuation(jobs);
+    }
+
+    const std::size_t count = 1 << 24;
+    const std::size_t grain = 1 << 14;
+
+    auto start = Clock::now();
+    volatile double serialSum = workload(0, count);
+    (void)serialSum;
+    double serial = secondsSince(start);
+
+    std::printf("\nparallel_for scaling (%zu items, grain %zu)\n", count, grain);
+    std::printf("  serial            %8.2f ms\n", serial * 1000.0);
+
+    // The calling thread also runs chunks, so N workers use N + 1 threads
+    for (std::size_t workers = 1; workers < hardware * 2; workers *= 2) {
+        JobSystem jobs(workers);
+        runParallelFor(jobs, count, grain); // Warm up threads and caches
+        double seconds = runParallelFor(jobs, count, grain);
+        std::printf("  %2zu workers + main %8.2f ms   %5.2fx\n", workers, seconds * 1000.0, serial / seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,623 @@
+// Run simulator: plays whole runs without a window. Each run rolls the die
+// and walks the map by MapState's auto-path rules, fights every encounter it
+// triggers through the combat engine and applies Player's progression:
+// experience and levels, evolution at EVOLUTION_LEVEL and an upgrade choice
+// whenever VICTORIES_FOR_UPGRADE victories add points. Runs are played in
+// parallel batches per map seed; for each map it reports how many runs reach
+// the goal, the level curve, evolution timing and the boss win rate. Results
+// for a seed are the same whatever the thread count. Build with
+// -DBUILD_BENCHMARKS=ON and run ./run_sim from the build directory.
+#include "core/CombatEngine.h"
+#include "core/FastRNG.h"
+#include "core/JobSystem.h"
+#include "core/RNG.h"
+#include "world/Map.h"
+#include "Constants.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Action = CombatEngine::Action;
+    using Encounter = CombatEngine::Encounter;
+
+    // A run still going after this many rolls counts as unfinished
+    const int MaxTurns = 500;
+    // A battle that has not ended by then counts as lost
+    const int MaxSteps = 1000;
+    const std::size_t ChunkCount = 64;
+    // 95% two-sided
+    const double Z = 1.96;
+    // Level curve rows; higher levels count as this one
+    const int MaxLevel = 10;
+
+    // MapState's step priority: Right, Down, Up, Left
+    const Vec2i Directions[4] = {{1, 0}, {0, 1}, {0, -1}, {-1, 0}};
+
+    const char* const EncounterNames[] = {"chalamander", "bisasam", "boss"};
+
+    enum class Upgrade { Attack, Defense, Health, Random };
+
+    struct Options {
+        Upgrade upgrade = Upgrade::Random;
+        bool growth = false;    // Levels and upgrades add to the battle stats; the game's never change
+    };
+
+    // A generated map as flat tiles, with what the walk needs from the gates
+    struct Layout {
+        unsigned int seed;              // 0 is the fixed map the game plays
+        int width;
+        int height;
+        Vec2i start;
+        Vec2i goal;
+        std::vector<TileType> tiles;
+        std::vector<Vec2i> gateTargets; // Per tile; the tile itself when it has no gate
+        std::vector<Vec2i> monsters;    // In the map's order
+        std::vector<Encounter> encounters;
+        bool hasBoss;
+
+        int index(const Vec2i& pos) const { return pos.y * width + pos.x; }
+        bool inside(const Vec2i& pos) const { return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height; }
+    };
+
+    // Generated once per seed, the way MapState and the map generators do it.
+    // Monsters are what MapState::checkCombatTrigger starts: Bisasam at the
+    // fixed map's (8,22), Chalamander anywhere else. generateMaze also puts
+    // the boss at the goal, which the game, playing only the fixed map, never
+    // reaches; it is fought as the boss encounter here
+    Layout makeLayout(unsigned int seed) {
+        Map map;
+        if (seed == 0) {
+            map.generateFixedMap();
+        } else {
+            RNG rng;
+            map.generateMaze(rng, seed);
+        }
+
+        Layout layout;
+        layout.seed = seed;
+        layout.width = map.getWidth();
+        layout.height = map.getHeight();
+        layout.start = map.getStartPosition();
+        layout.goal = map.getGoalPosition();
+        layout.hasBoss = false;
+        for (int y = 0; y < layout.height; ++y) {
+            for (int x = 0; x < layout.width; ++x) {
+                Vec2i pos(x, y);
+                const TeleportGate* gate = map.getTeleportGate(pos);
+                layout.tiles.push_back(map.getTileType(pos));
+                layout.gateTargets.push_back(gate ? gate->targetPosition : pos);
+            }
+        }
+
+        for (const Vec2i& monster : map.getMonsterPositions()) {
+            Encounter encounter = monster == Vec2i(8, 22) ? Encounter::Bisasam : Encounter::Chalamander;
+            if (monster == layout.goal) {
+                encounter = Encounter::Boss;
+                layout.hasBoss = true;
+            }
+            layout.monsters.push_back(monster);
+            layout.encounters.push_back(encounter);
+        }
+        return layout;
+    }
+
+    int distance(const Vec2i& a, const Vec2i& b) {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+
+    // Player's progression (addVictory, gainExperience, levelUp, the
+    // upgrades) on plain numbers: the entity also brings a sprite, a visited
+    // grid and a Pokemon, none of which a run needs. Player::evolve leaves
+    // the stats alone, so evolving here only sets the flag
+    struct Progress {
+        int level = 1;
+        int experience = 0;
+        int victories = 0;
+        int upgradePoints = 0;
+        int hp = 0;             // Gained over the level 1 stats
+        int atk = 0;
+        int def = 0;
+        bool evolved = false;
+
+        void addVictory() {
+            ++victories;
+            experience += 50;
+            if (experience >= level * 100) {
+                ++level;
+                hp += Constants::HP_PER_LEVEL;
+                atk += Constants::ATK_PER_LEVEL;
+                def += Constants::DEF_PER_LEVEL;
+            }
+            if (victories % Constants::VICTORIES_FOR_UPGRADE == 0) {
+                upgradePoints += Constants::UPGRADE_POINTS_PER_VICTORIES;
+            }
+        }
+
+        // All points go to one stat, as the upgrade screen spends them
+        void spendPoints(Upgrade upgrade, FastRNG& rng) {
+            if (upgradePoints == 0) return;
+            if (upgrade == Upgrade::Random) {
+                upgrade = static_cast<Upgrade>(rng.rollRange(0, 2));
+            }
+            switch (upgrade) {
+                case Upgrade::Attack:  atk += upgradePoints; break;
+                case Upgrade::Defense: def += upgradePoints; break;
+                default:               hp += upgradePoints * 5; break;
+            }
+            upgradePoints = 0;
+        }
+
+        bool canEvolve() const { return level >= Constants::EVOLUTION_LEVEL && !evolved; }
+    };
+
+    struct Tally {
+        std::uint64_t runs = 0;
+        std::uint64_t cleared = 0;      // Reached the goal
+        std::uint64_t stuck = 0;        // A roll of 2 or more found no step: no later roll will
+        std::uint64_t clearTurnSum = 0;
+        double clearTurnSquares = 0.0;
+        std::uint64_t battles = 0;
+        std::uint64_t defeats = 0;
+        std::uint64_t bossFights = 0;
+        std::uint64_t bossWins = 0;
+        std::uint64_t finalLevelSum = 0;
+        std::array<std::uint64_t, MaxLevel + 1> levelReached{};
+        std::array<std::uint64_t, MaxLevel + 1> levelTurnSum{};
+        std::uint64_t evolved = 0;
+        std::uint64_t evolveTurnSum = 0;
+        std::vector<std::uint64_t> stuckAt;     // Per tile, sized on the first stuck run
+
+        void merge(const Tally& other) {
+            runs += other.runs;
+            cleared += other.cleared;
+            stuck += other.stuck;
+            clearTurnSum += other.clearTurnSum;
+            clearTurnSquares += other.clearTurnSquares;
+            battles += other.battles;
+            defeats += other.defeats;
+            bossFights += other.bossFights;
+            bossWins += other.bossWins;
+            finalLevelSum += other.finalLevelSum;
+            for (int level = 0; level <= MaxLevel; ++level) {
+                levelReached[level] += other.levelReached[level];
+                levelTurnSum[level] += other.levelTurnSum[level];
+            }
+            evolved += other.evolved;
+            evolveTurnSum += other.evolveTurnSum;
+            if (stuckAt.size() < other.stuckAt.size()) stuckAt.resize(other.stuckAt.size());
+            for (std::size_t tile = 0; tile < other.stuckAt.size(); ++tile) stuckAt[tile] += other.stuckAt[tile];
+        }
+    };
+
+    // The simulated player in battle: random coin calls and a random choice
+    // whenever a skill menu opens, winrate_sim's default policy
+    Action chooseAction(const CombatEngine::State& state, FastRNG& rng) {
+        if (state.phase == CombatEngine::Phase::CoinChoice) {
+            return rng.rollRange(0, 1) == 0 ? Action::CallHead : Action::CallTail;
+        }
+        if (!state.skillMenu) {
+            return Action::Attack;
+        }
+        if (state.defending) {
+            return static_cast<Action>(static_cast<int>(Action::Skill1) + rng.rollRange(0, 2));
+        }
+        int pick = rng.rollRange(0, 3);
+        return pick == 0 ? Action::Attack : static_cast<Action>(static_cast<int>(Action::Skill1) + pick - 1);
+    }
+
+    // The battle CombatState starts: the encounter's stats at full HP, and no
+    // MP for regular enemies, which only attack. The boss is an approximation:
+    // it only attacks too, since its move search would cost more than the run
+    bool fight(CombatEngine& engine, Encounter encounter, const Progress& progress, const Options& options,
+               FastRNG& rng) {
+        CombatEngine::State start = CombatEngine::makeEncounterState(encounter);
+        if (encounter != Encounter::Boss) start.enemy.mp = 0;
+        if (options.growth) {
+            start.player.hp += progress.hp;
+            start.player.maxHp += progress.hp;
+            start.player.atk += progress.atk;
+            start.player.def += progress.def;
+        }
+        engine.reset(start);
+
+        for (int steps = 0; !engine.isOver() && steps < MaxSteps; ++steps) {
+            engine.step(chooseAction(engine.getState(), rng), rng);
+        }
+        return engine.getState().phase == CombatEngine::Phase::Victory;
+    }
+
+    // One run's copy of the map, reused from run to run by a work item
+    struct Walk {
+        std::vector<TileType> tiles;
+        std::vector<char> visited;
+        std::vector<std::size_t> alive;     // Indices into the layout's monsters
+        Vec2i position;
+        int remaining = 0;
+        bool justTeleported = false;
+
+        void reset(const Layout& layout) {
+            tiles = layout.tiles;
+            visited.assign(tiles.size(), 0);
+            alive.clear();
+            for (std::size_t i = 0; i < layout.monsters.size(); ++i) alive.push_back(i);
+            position = layout.start;
+            visited[layout.index(position)] = 1;
+        }
+
+        void moveTo(const Layout& layout, const Vec2i& pos) {
+            position = pos;
+            visited[layout.index(pos)] = 1;
+        }
+
+        // Map::teleportNext: the first empty tile next to the gate's target
+        bool teleportNext(const Layout& layout, const Vec2i& portal, Vec2i& destination) const {
+            Vec2i target = layout.gateTargets[layout.index(portal)];
+            if (target == portal) return false;
+            for (const Vec2i& dir : Directions) {
+                Vec2i next = target + dir;
+                if (layout.inside(next) && tiles[layout.index(next)] == TileType::Empty) {
+                    destination = next;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // MapState::pickNextPosition
+        bool pickNext(const Layout& layout, Vec2i& next) {
+            for (const Vec2i& dir : Directions) {
+                next = position + dir;
+                if (!layout.inside(next) || visited[layout.index(next)]) continue;
+
+                switch (tiles[layout.index(next)]) {
+                    case TileType::Rock:
+                        if (remaining < 2) continue;
+                        tiles[layout.index(next)] = TileType::Empty;
+                        remaining -= 2;
+                        return true;
+
+                    case TileType::PortalA:
+                    case TileType::PortalB: {
+                        Vec2i destination;
+                        if (!justTeleported && teleportNext(layout, next, destination)
+                            && !visited[layout.index(destination)]) {
+                            justTeleported = true;
+                            next = destination;
+                            return true;
+                        }
+                        continue;
+                    }
+
+                    case TileType::Goal:
+                    case TileType::Empty:
+                    case TileType::Enemy:
+                        return true;
+
+                    default:
+                        continue;
+                }
+            }
+            return false;
+        }
+
+        // MapState::onCombatEnded after a victory: onto the monster's tile,
+        // then one step further if a tile in priority order allows it
+        void winAt(const Layout& layout, std::size_t aliveIndex) {
+            const Vec2i monster = layout.monsters[alive[aliveIndex]];
+            alive.erase(alive.begin() + static_cast<std::ptrdiff_t>(aliveIndex));
+            TileType& tile = tiles[layout.index(monster)];
+            if (tile == TileType::Enemy) tile = TileType::Empty;
+
+            moveTo(layout, monster);
+            for (const Vec2i& dir : Directions) {
+                Vec2i next = monster + dir;
+                if (!layout.inside(next) || visited[layout.index(next)]) continue;
+                TileType type = tiles[layout.index(next)];
+                if (type != TileType::Wall && type != TileType::Rock) {
+                    moveTo(layout, next);
+                    break;
+                }
+            }
+        }
+    };
+
+    void reachLevel(Tally& tally, int level, int turn) {
+        level = std::min(level, MaxLevel);
+        ++tally.levelReached[level];
+        tally.levelTurnSum[level] += static_cast<std::uint64_t>(turn);
+    }
+
+    void playRun(const Layout& layout, const Options& options, CombatEngine& engine, Walk& walk, FastRNG& rng,
+                 Tally& tally) {
+        walk.reset(layout);
+        Progress progress;
+        ++tally.runs;
+
+        for (int turn = 1; turn <= MaxTurns; ++turn) {
+            // MapState::walkPath for one roll: a monster within reach of the
+            // steps left starts combat, the goal within reach ends the run
+            const int roll = rng.rollRange(1, 6);
+            walk.remaining = roll;
+            walk.justTeleported = false;
+            bool moved = false;
+            std::size_t trigger = walk.alive.size();
+
+            while (walk.remaining > 0) {
+                Vec2i next;
+                if (!walk.pickNext(layout, next)) break;
+                walk.moveTo(layout, next);
+                moved = true;
+                --walk.remaining;
+
+                for (std::size_t i = 0; i < walk.alive.size(); ++i) {
+                    if (distance(walk.position, layout.monsters[walk.alive[i]]) <= walk.remaining) {
+                        trigger = i;
+                        walk.remaining = 0;
+                        break;
+                    }
+                }
+                if (walk.position == layout.goal || distance(walk.position, layout.goal) < walk.remaining) {
+                    ++tally.cleared;
+                    tally.clearTurnSum += static_cast<std::uint64_t>(turn);
+                    tally.clearTurnSquares += static_cast<double>(turn) * turn;
+                    tally.finalLevelSum += static_cast<std::uint64_t>(progress.level);
+                    return;
+                }
+            }
+
+            if (!moved && roll >= 2) {
+                ++tally.stuck;
+                tally.stuckAt.resize(layout.tiles.size());
+                ++tally.stuckAt[layout.index(walk.position)];
+                break;
+            }
+            if (trigger == walk.alive.size()) continue;
+
+            Encounter encounter = layout.encounters[walk.alive[trigger]];
+            bool victory = fight(engine, encounter, progress, options, rng);
+            ++tally.battles;
+            if (encounter == Encounter::Boss) {
+                ++tally.bossFights;
+                tally.bossWins += victory;
+            }
+            if (!victory) {
+                // The player stays put and the monster waits for the next roll
+                ++tally.defeats;
+                continue;
+            }
+
+            walk.winAt(layout, trigger);
+            int level = progress.level;
+            progress.addVictory();
+            progress.spendPoints(options.upgrade, rng);
+            if (progress.level != level) reachLevel(tally, progress.level, turn);
+            if (progress.canEvolve()) {
+                progress.evolved = true;
+                ++tally.evolved;
+                tally.evolveTurnSum += static_cast<std::uint64_t>(turn);
+            }
+        }
+        tally.finalLevelSum += static_cast<std::uint64_t>(progress.level);
+    }
+
+    // Stream k is the seed's generator jumped k times: 2^128 draws apart.
+    // Every map plays the same streams
+    std::vector<FastRNG> makeStreams(std::uint64_t seed, std::uint64_t runs) {
+        std::vector<FastRNG> streams;
+        FastRNG stream(seed);
+        for (std::size_t i = 0; i < std::min<std::uint64_t>(ChunkCount, runs); ++i) {
+            streams.push_back(stream);
+            stream.jump();
+        }
+        return streams;
+    }
+
+    // The whole value as a decimal number; std::stoull would throw on "abc"
+    template <typename T>
+    bool parseNumber(const std::string& value, T& out) {
+        const char* end = value.data() + value.size();
+        auto [last, error] = std::from_chars(value.data(), end, out);
+        return error == std::errc() && last == end;
+    }
+
+    bool parseMaps(const std::string& value, std::vector<unsigned int>& seeds) {
+        seeds.clear();
+        const char* cursor = value.c_str();
+        while (*cursor != '\0') {
+            char* end = nullptr;
+            unsigned long seed = std::strtoul(cursor, &end, 10);
+            if (end == cursor || (*end != ',' && *end != '\0')) return false;
+            seeds.push_back(static_cast<unsigned int>(seed));
+            cursor = *end == ',' ? end + 1 : end;
+        }
+        return !seeds.empty();
+    }
+
+    bool parseUpgrade(const std::string& value, Upgrade& upgrade) {
+        if (value == "attack") upgrade = Upgrade::Attack;
+        else if (value == "defense") upgrade = Upgrade::Defense;
+        else if (value == "health") upgrade = Upgrade::Health;
+        else if (value == "random") upgrade = Upgrade::Random;
+        else return false;
+        return true;
+    }
+
+    double percent(std::uint64_t part, std::uint64_t whole) {
+        return whole > 0 ? 100.0 * static_cast<double>(part) / whole : 0.0;
+    }
+
+    void printLayout(const Layout& layout, const Tally& tally) {
+        const double runs = static_cast<double>(tally.runs);
+        std::printf("\nMap %u (%s): ", layout.seed, layout.seed == 0 ? "fixed map" : "maze");
+        for (std::size_t i = 0; i < layout.monsters.size(); ++i) {
+            std::printf("%s%s (%d,%d)", i > 0 ? ", " : "", EncounterNames[static_cast<int>(layout.encounters[i])],
+                        layout.monsters[i].x, layout.monsters[i].y);
+        }
+        std::printf("%s\n", layout.hasBoss ? "" : ", no boss");
+
+        double meanTurns = tally.cleared > 0 ? static_cast<double>(tally.clearTurnSum) / tally.cleared : 0.0;
+        double variance = tally.cleared > 1
+            ? (tally.clearTurnSquares - tally.clearTurnSum * meanTurns) / (tally.cleared - 1) : 0.0;
+        double turnSpread = tally.cleared > 1 ? Z * std::sqrt(std::max(variance, 0.0) / tally.cleared) : 0.0;
+        std::printf("  goal    %6.2f%%  in %6.2f +/- %4.2f rolls   stuck %6.2f%%   unfinished %6.2f%%\n",
+                    percent(tally.cleared, tally.runs), meanTurns, turnSpread, percent(tally.stuck, tally.runs),
+                    percent(tally.runs - tally.cleared - tally.stuck, tally.runs));
+        std::printf("  battles %6.2f per run, %4.2f lost       final level %4.2f\n", tally.battles / runs,
+                    tally.defeats / runs, tally.finalLevelSum / runs);
+
+        // Where the walk ran out of unvisited tiles, most often first
+        std::vector<std::size_t> tiles;
+        for (std::size_t tile = 0; tile < tally.stuckAt.size(); ++tile) {
+            if (tally.stuckAt[tile] > 0) tiles.push_back(tile);
+        }
+        std::sort(tiles.begin(), tiles.end(), [&](std::size_t a, std::size_t b) {
+            return tally.stuckAt[a] > tally.stuckAt[b];
+        });
+        if (!tiles.empty()) {
+            std::printf("  stuck at");
+            for (std::size_t i = 0; i < std::min<std::size_t>(3, tiles.size()); ++i) {
+                std::printf("  (%d,%d) %.2f%%", static_cast<int>(tiles[i] % layout.width),
+                            static_cast<int>(tiles[i] / layout.width), percent(tally.stuckAt[tiles[i]], tally.runs));
+            }
+            std::printf("\n");
+        }
+
+        if (layout.hasBoss) {
+            double p = tally.bossFights > 0 ? static_cast<double>(tally.bossWins) / tally.bossFights : 0.0;
+            double spread = tally.bossFights > 0 ? Z * std::sqrt(p * (1.0 - p) / tally.bossFights) : 0.0;
+            std::printf("  boss    %6.2f%% +/- %4.2f per fight over %llu fights, beaten in %6.2f%% of runs"
+                        " (attacks only: approximate)\n",
+                        100.0 * p, 100.0 * spread, static_cast<unsigned long long>(tally.bossFights),
+                        percent(tally.bossWins, tally.runs));
+        }
+
+        if (tally.levelReached[2] == 0) {
+            std::printf("  no run leveled up\n");
+        } else {
+            std::printf("  level   reached   mean roll\n");
+        }
+        for (int level = 2; level <= MaxLevel; ++level) {
+            if (tally.levelReached[level] == 0) break;
+            std::printf("  %5d%s  %6.2f%%   %9.2f\n", level, level == MaxLevel ? "+" : " ",
+                        percent(tally.levelReached[level], tally.runs),
+                        static_cast<double>(tally.levelTurnSum[level]) / tally.levelReached[level]);
+        }
+
+        if (tally.evolved > 0) {
+            std::printf("  evolved in %6.2f%% of runs, at roll %.2f on average\n", percent(tally.evolved, tally.runs),
+                        static_cast<double>(tally.evolveTurnSum) / tally.evolved);
+        } else {
+            std::printf("  no run reached EVOLUTION_LEVEL %d\n", Constants::EVOLUTION_LEVEL);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* usage = " [--maps SEED,...] [--runs N] [--upgrade attack|defense|health|random] [--growth]"
+                        " [--seed S] [--threads T]";
+
+    std::vector<unsigned int> seeds = {0, 1, 2, 3, 4, 5, 6, 7};
+    Options options;
+    std::uint64_t runs = 1000000;
+    std::uint64_t seed = 42;
+    std::size_t threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << usage << std::endl;
+            std::cout << "Map seed 0 is the fixed map the game plays; others are generateMaze seeds." << std::endl;
+            return 0;
+        }
+        else if (arg == "--maps" && i + 1 < argc) {
+            ok = parseMaps(argv[++i], seeds);
+        }
+        else if (arg == "--runs" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], runs);
+        }
+        else if (arg == "--upgrade" && i + 1 < argc) {
+            ok = parseUpgrade(argv[++i], options.upgrade);
+        }
+        else if (arg == "--growth") {
+            options.growth = true;
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], seed);
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], threads);
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok || runs == 0) {
+            std::cerr << "Bad argument: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0] << usage << std::endl;
+            return 1;
+        }
+    }
+
+    // The calling thread works too, so one worker fewer than requested;
+    // --threads 1 keeps everything on the calling thread
+    const bool serial = threads == 1;
+    JobSystem jobs(threads > 1 ? threads - 1 : (serial ? 1 : 0));
+    std::size_t workers = serial ? 1 : jobs.getWorkerCount() + 1;
+
+    const char* upgradeNames[] = {"attack", "defense", "health", "random"};
+    std::printf("Run simulator: %llu runs per map, seed %llu, %zu threads\n", static_cast<unsigned long long>(runs),
+                static_cast<unsigned long long>(seed), workers);
+    std::printf("Random coin and skill choices, upgrade points to %s, %s\n",
+                upgradeNames[static_cast<int>(options.upgrade)],
+                options.growth ? "levels and upgrades add to battle stats" : "fixed battle stats as in the game");
+    std::printf("The boss only attacks; the game's also picks Power Strike and Guard by search\n");
+
+    std::vector<Layout> layouts;
+    for (unsigned int mapSeed : seeds) layouts.push_back(makeLayout(mapSeed));
+    const std::vector<FastRNG> streams = makeStreams(seed, runs);
+    const std::size_t chunks = streams.size();
+
+    // One work item per map and stream, merged per map once all are done
+    auto begin = Clock::now();
+    std::vector<Tally> tallies(layouts.size() * chunks);
+    auto body = [&](std::size_t first, std::size_t last) {
+        CombatEngine engine;
+        Walk walk;
+        for (std::size_t item = first; item < last; ++item) {
+            std::size_t chunk = item % chunks;
+            const Layout& layout = layouts[item / chunks];
+            FastRNG rng = streams[chunk];
+            std::uint64_t count = runs / chunks + (chunk < runs % chunks ? 1 : 0);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                playRun(layout, options, engine, walk, rng, tallies[item]);
+            }
+        }
+    };
+    if (serial) {
+        body(0, tallies.size());
+    } else {
+        jobs.parallelFor(tallies.size(), 1, body);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    for (std::size_t map = 0; map < layouts.size(); ++map) {
+        Tally tally;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) tally.merge(tallies[map * chunks + chunk]);
+        printLayout(layouts[map], tally);
+    }
+
+    double total = static_cast<double>(runs) * layouts.size();
+    std::printf("\n%.0f runs in %.2f s: %.0f runs per minute\n", total, seconds, 60.0 * total / seconds);
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Boss move search benchmark: nodes searched per second, depth reached and
+// decision latency percentiles under time and node budgets.
+// Build with -DBUILD_BENCHMARKS=ON and run ./search_bench from the build directory.
+#include "core/CombatEngine.h"
+#include "core/CombatSearch.h"
+#include "core/FastRNG.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Action = CombatEngine::Action;
+    using EnemyMove = CombatEngine::EnemyMove;
+
+    const int PositionCount = 400;
+    const int MaxSteps = 1000;
+
+    // The game's boss battle
+    CombatEngine::State bossBattle() {
+        return CombatEngine::makeEncounterState(CombatEngine::Encounter::Boss);
+    }
+
+    // Enemy coin-call states from random battles, in battle order
+    std::vector<CombatEngine::State> samplePositions(FastRNG& rng) {
+        std::vector<CombatEngine::State> positions;
+        CombatEngine engine;
+        while (static_cast<int>(positions.size()) < PositionCount) {
+            engine.reset(bossBattle());
+            for (int steps = 0; steps < MaxSteps && !engine.isOver(); ++steps) {
+                if (engine.getState().phase == CombatEngine::Phase::CoinChoice) {
+                    engine.setEnemyMove(static_cast<EnemyMove>(rng.rollRange(0, 2)));
+                    positions.push_back(engine.getState());
+                }
+
+                Action action;
+                do {
+                    action = static_cast<Action>(rng.rollRange(0, 5));
+                } while (!engine.canStep(action));
+                engine.step(action, rng);
+            }
+        }
+        positions.resize(PositionCount);
+        return positions;
+    }
+
+    // values must be sorted
+    long long percentile(const std::vector<long long>& values, double fraction) {
+        std::size_t index = static_cast<std::size_t>(fraction * (values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+    // clearEach: every decision starts from an empty table (cold); otherwise
+    // the table carries over between consecutive positions, as within a battle
+    void bench(const char* name, const std::vector<CombatEngine::State>& positions,
+               const CombatSearch::Limits& limits, bool clearEach) {
+        CombatSearch search(Constants::BOSS_SEARCH_PLAYER_SKILL);
+        std::vector<long long> latencies;
+        latencies.reserve(positions.size());
+        std::uint64_t nodes = 0;
+        long long depthSum = 0;
+        double seconds = 0.0;
+
+        for (const CombatEngine::State& position : positions) {
+            if (clearEach) search.clearTable();
+
+            auto start = Clock::now();
+            CombatSearch::Result result = search.chooseEnemyMove(position, limits);
+            auto elapsed = Clock::now() - start;
+
+            latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+            seconds += std::chrono::duration<double>(elapsed).count();
+            nodes += result.nodes;
+            depthSum += result.depth;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("  %-22s %6.2f M nodes/s  depth %5.2f  latency us p50 %5lld  p90 %5lld  p99 %5lld  max %5lld\n",
+                    name, nodes / seconds / 1e6, static_cast<double>(depthSum) / positions.size(),
+                    percentile(latencies, 0.5), percentile(latencies, 0.9), percentile(latencies, 0.99),
+                    latencies.back());
+    }
+}
+
+int main() {
+    FastRNG rng(42);
+    std::vector<CombatEngine::State> positions = samplePositions(rng);
+    std::printf("Boss move search benchmark (%d positions from random battles)\n", PositionCount);
+
+    std::printf("Time limit, cold table\n");
+    for (int microseconds : {100, 500, 2000, 10000}) {
+        CombatSearch::Limits limits;
+        limits.maxDepth = Constants::BOSS_SEARCH_DEPTH;
+        limits.timeLimit = std::chrono::microseconds(microseconds);
+        char name[32];
+        std::snprintf(name, sizeof(name), "%d us", microseconds);
+        bench(name, positions, limits, true);
+    }
+
+    // No time limit, as in the game: the latencies show what the budget costs here
+    std::printf("Game budget (%d nodes, depth %d)\n", Constants::BOSS_SEARCH_NODES, Constants::BOSS_SEARCH_DEPTH);
+    CombatSearch::Limits game;
+    game.maxDepth = Constants::BOSS_SEARCH_DEPTH;
+    game.maxNodes = Constants::BOSS_SEARCH_NODES;
+    bench("cold table", positions, game, true);
+    bench("table kept", positions, game, false);
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Skill system benchmark: cost of setting up entities with their skills and
+// of using skills through the entity API, with heap allocations counted.
+// Build with -DBUILD_BENCHMARKS=ON and run ./skill_bench from the build directory.
+#include "entities/Pokemon.h"
+#include "entities/Enemy.h"
+#include "core/AllocationCounter.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const int SetupCount = 100000;
+    const int UseCount = 10000000;
+
+    template <typename Create>
+    void benchSetup(const char* name, Create create) {
+        std::uint64_t allocations = AllocationCounter::count();
+        auto start = Clock::now();
+        int alive = 0;
+        for (int i = 0; i < SetupCount; ++i) {
+            auto entity = create();
+            alive += entity->isAlive();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        allocations = AllocationCounter::count() - allocations;
+
+        std::printf("  %-10s %8.1f ns/entity  %5.2f allocations/entity  (%d alive)\n",
+                    name, seconds * 1e9 / SetupCount, static_cast<double>(allocations) / SetupCount, alive);
+    }
+
+    void benchUse() {
+        std::unique_ptr<Pokemon> attacker = Pokemon::createBlazeling();
+        attacker->evolve();
+        std::unique_ptr<Enemy> target = Enemy::createRegularEnemy();
+        const SkillType rotation[] = {SkillType::PowerStrike, SkillType::Heal, SkillType::Fireball};
+
+        std::uint64_t allocations = AllocationCounter::count();
+        auto start = Clock::now();
+        long long damage = 0;
+        for (int i = 0; i < UseCount; ++i) {
+            SkillType skill = rotation[i % 3];
+            if (attacker->canUseSkill(skill)) {
+                int before = target->getCurrentHP();
+                attacker->useSkill(skill, *target);
+                damage += before - target->getCurrentHP();
+            }
+            attacker->updateCooldowns();
+
+            // Keep both sides fighting
+            attacker->setCurrentMP(attacker->getMaxMP());
+            target->setCurrentHP(target->getMaxHP());
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        allocations = AllocationCounter::count() - allocations;
+
+        std::printf("  %-10s %8.1f ns/turn    %5.2f allocations/turn    (%lld damage)\n",
+                    "Blazeling", seconds * 1e9 / UseCount, static_cast<double>(allocations) / UseCount, damage);
+    }
+}
+
+int main() {
+    std::printf("Entity setup (%d each, created and destroyed)\n", SetupCount);
+    benchSetup("Blazeling", [] { return Pokemon::createBlazeling(); });
+    benchSetup("Aquary", [] { return Pokemon::createAquary(); });
+    benchSetup("Verdil", [] { return Pokemon::createVerdil(); });
+    benchSetup("Enemy", [] { return Enemy::createRegularEnemy(); });
+
+    std::printf("Skill use (%d turns: check, use, tick cooldowns)\n", UseCount);
+    benchUse();
+    return 0;
+}
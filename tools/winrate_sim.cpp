@@ -0,0 +1,389 @@
+// Monte Carlo win-rate estimator: simulates battles against each encounter
+// under a fixed coin-call and skill policy, spread over every core.
+// Build with -DBUILD_BENCHMARKS=ON and run ./winrate_sim from the build directory.
+#include "core/CombatEngine.h"
+#include "core/CombatSolver.h"
+#include "core/FastRNG.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Action = CombatEngine::Action;
+    using Encounter = CombatEngine::Encounter;
+
+    // A battle that has not ended by then is counted as stalled
+    const int MaxSteps = 1000;
+    // Turns past this land in the last histogram slot
+    const int MaxTurns = 127;
+    const int HpBins = 10;
+    // Work is cut into this many chunks, each with its own generator stream,
+    // so the result for a seed does not depend on the thread count
+    const std::size_t ChunkCount = 1024;
+    // 95% two-sided
+    const double Z = 1.96;
+
+    enum class CoinPolicy { Head, Tail, Random };
+    // What to do with a right attack call: Strike is the doubled Attack
+    enum class AttackPolicy { Strike, Thunderbolt, ElectroBall, VoltTackle, Random };
+    enum class DefensePolicy { QuickGuard, Agility, Charge, Random };
+
+    struct Policy {
+        CoinPolicy coin = CoinPolicy::Random;
+        AttackPolicy attack = AttackPolicy::Random;
+        DefensePolicy defense = DefensePolicy::Random;
+    };
+
+    // Per-chunk counters, merged once every chunk is done
+    struct Tally {
+        std::uint64_t battles = 0;
+        std::uint64_t victories = 0;
+        std::uint64_t stalled = 0;
+        std::array<std::uint64_t, MaxTurns + 1> turns{};    // Coin calls, victories only
+        std::array<std::uint64_t, HpBins> hp{};             // Remaining HP share, victories only
+        double turnSum = 0.0, turnSquares = 0.0;
+        double hpSum = 0.0, hpSquares = 0.0;
+
+        void merge(const Tally& other) {
+            battles += other.battles;
+            victories += other.victories;
+            stalled += other.stalled;
+            for (std::size_t i = 0; i < turns.size(); ++i) turns[i] += other.turns[i];
+            for (std::size_t i = 0; i < hp.size(); ++i) hp[i] += other.hp[i];
+            turnSum += other.turnSum;
+            turnSquares += other.turnSquares;
+            hpSum += other.hpSum;
+            hpSquares += other.hpSquares;
+        }
+    };
+
+    Action chooseAction(const CombatEngine::State& state, const Policy& policy, FastRNG& rng) {
+        if (state.phase == CombatEngine::Phase::CoinChoice) {
+            bool head = policy.coin == CoinPolicy::Head
+                     || (policy.coin == CoinPolicy::Random && rng.rollRange(0, 1) == 0);
+            return head ? Action::CallHead : Action::CallTail;
+        }
+        if (!state.skillMenu) {
+            // Only the Attack confirmation applies
+            return Action::Attack;
+        }
+
+        int pick;
+        if (state.defending) {
+            pick = policy.defense == DefensePolicy::Random ? rng.rollRange(0, 2) : static_cast<int>(policy.defense);
+            return static_cast<Action>(static_cast<int>(Action::Skill1) + pick);
+        }
+        pick = policy.attack == AttackPolicy::Random ? rng.rollRange(0, 3) : static_cast<int>(policy.attack);
+        return pick == 0 ? Action::Attack : static_cast<Action>(static_cast<int>(Action::Skill1) + pick - 1);
+    }
+
+    // The same policy as chooseAction, as the chance of picking each action
+    double policyWeight(const CombatEngine::State& state, const Policy& policy, Action action) {
+        if (state.phase == CombatEngine::Phase::CoinChoice) {
+            if (action != Action::CallHead && action != Action::CallTail) return 0.0;
+            if (policy.coin == CoinPolicy::Random) return 0.5;
+            return (action == Action::CallHead) == (policy.coin == CoinPolicy::Head) ? 1.0 : 0.0;
+        }
+        if (!state.skillMenu) {
+            return action == Action::Attack ? 1.0 : 0.0;
+        }
+
+        int pick;
+        if (state.defending) {
+            if (action == Action::CallHead || action == Action::CallTail || action == Action::Attack) return 0.0;
+            pick = static_cast<int>(action) - static_cast<int>(Action::Skill1);
+            if (policy.defense == DefensePolicy::Random) return 1.0 / 3.0;
+            return pick == static_cast<int>(policy.defense) ? 1.0 : 0.0;
+        }
+        if (action == Action::CallHead || action == Action::CallTail) return 0.0;
+        pick = action == Action::Attack ? 0 : static_cast<int>(action) - static_cast<int>(Action::Skill1) + 1;
+        if (policy.attack == AttackPolicy::Random) return 0.25;
+        return pick == static_cast<int>(policy.attack) ? 1.0 : 0.0;
+    }
+
+    void runBattle(CombatEngine& engine, const CombatEngine::State& start, const Policy& policy,
+                   FastRNG& rng, Tally& tally) {
+        engine.reset(start);
+
+        int steps = 0;
+        int turns = 0;
+        while (!engine.isOver() && steps < MaxSteps) {
+            Action action = chooseAction(engine.getState(), policy, rng);
+            turns += action == Action::CallHead || action == Action::CallTail;
+            engine.step(action, rng);
+            ++steps;
+        }
+
+        ++tally.battles;
+        const CombatEngine::State& state = engine.getState();
+        if (!engine.isOver()) {
+            ++tally.stalled;
+            return;
+        }
+        if (state.phase != CombatEngine::Phase::Victory) return;
+
+        ++tally.victories;
+        ++tally.turns[std::min(turns, MaxTurns)];
+        tally.turnSum += turns;
+        tally.turnSquares += static_cast<double>(turns) * turns;
+
+        double share = static_cast<double>(state.player.hp) / state.player.maxHp;
+        ++tally.hp[std::min(static_cast<int>(share * HpBins), HpBins - 1)];
+        tally.hpSum += share;
+        tally.hpSquares += share * share;
+    }
+
+    // Wilson score interval for successes out of trials
+    void wilson(std::uint64_t successes, std::uint64_t trials, double& low, double& high) {
+        if (trials == 0) {
+            low = high = 0.0;
+            return;
+        }
+        double n = static_cast<double>(trials);
+        double p = successes / n;
+        double denominator = 1.0 + Z * Z / n;
+        double centre = (p + Z * Z / (2.0 * n)) / denominator;
+        double spread = Z * std::sqrt(p * (1.0 - p) / n + Z * Z / (4.0 * n * n)) / denominator;
+        low = centre - spread;
+        high = centre + spread;
+    }
+
+    // Mean and the half-width of its normal-approximation interval
+    void meanInterval(double sum, double squares, std::uint64_t count, double& mean, double& halfWidth) {
+        mean = count > 0 ? sum / count : 0.0;
+        double variance = count > 1 ? (squares - sum * mean) / (count - 1) : 0.0;
+        halfWidth = count > 1 ? Z * std::sqrt(std::max(variance, 0.0) / count) : 0.0;
+    }
+
+    int percentile(const Tally& tally, double fraction) {
+        std::uint64_t target = static_cast<std::uint64_t>(std::ceil(fraction * tally.victories));
+        std::uint64_t seen = 0;
+        for (int turns = 0; turns <= MaxTurns; ++turns) {
+            seen += tally.turns[turns];
+            if (seen >= std::max<std::uint64_t>(target, 1)) return turns;
+        }
+        return MaxTurns;
+    }
+
+    void printShare(const char* label, std::uint64_t count, std::uint64_t total) {
+        double low, high;
+        wilson(count, total, low, high);
+        double share = total > 0 ? 100.0 * count / total : 0.0;
+        int bar = static_cast<int>(share / 2.0 + 0.5);
+        std::printf("    %-9s %6.2f%%  [%6.2f, %6.2f]  %.*s\n", label, share, 100.0 * low, 100.0 * high,
+                    bar, "##################################################");
+    }
+
+    // Solves the encounter exactly, under the policy and under optimal play,
+    // and checks the estimate against it
+    void reportExact(Encounter encounter, const Policy& policy, const Tally& tally) {
+        const CombatEngine::State start = CombatEngine::makeEncounterState(encounter);
+        auto begin = Clock::now();
+        CombatSolver evaluator([&policy](const CombatEngine::State& state, Action action) {
+            return policyWeight(state, policy, action);
+        });
+        double exact = evaluator.winChance(start);
+        CombatSolver optimal;
+        double best = optimal.winChance(start);
+        double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+        double low, high;
+        wilson(tally.victories, tally.battles, low, high);
+        std::printf("  Exact     %.3f%% under the policy (%s the 95%% CI), %.3f%% with optimal play"
+                    "  [%zu states, %.1f ms]\n", 100.0 * exact, exact >= low && exact <= high ? "inside" : "OUTSIDE",
+                    100.0 * best, optimal.getSolvedCount(), milliseconds);
+    }
+
+    void report(const char* name, const Tally& tally, double seconds) {
+        double low, high;
+        wilson(tally.victories, tally.battles, low, high);
+        std::printf("\n%s: %llu battles in %.2f s (%.1f M/s)\n", name,
+                    static_cast<unsigned long long>(tally.battles), seconds, tally.battles / seconds / 1e6);
+        std::printf("  Win rate  %.3f%%  95%% CI [%.3f, %.3f]", 100.0 * tally.victories / tally.battles,
+                    100.0 * low, 100.0 * high);
+        if (tally.stalled > 0) {
+            std::printf("  (%llu stalled)", static_cast<unsigned long long>(tally.stalled));
+        }
+        std::printf("\n");
+        if (tally.victories == 0) return;
+
+        double mean, halfWidth;
+        meanInterval(tally.turnSum, tally.turnSquares, tally.victories, mean, halfWidth);
+        std::printf("  Turns to win (coin calls)  mean %.3f +/- %.3f  p5 %d  p25 %d  p50 %d  p75 %d  p95 %d\n",
+                    mean, halfWidth, percentile(tally, 0.05), percentile(tally, 0.25), percentile(tally, 0.5),
+                    percentile(tally, 0.75), percentile(tally, 0.95));
+
+        // Rows from p0.5 to p99.5, so the long tail does not flood the output
+        int first = percentile(tally, 0.005);
+        int last = percentile(tally, 0.995);
+        std::uint64_t before = 0, after = 0;
+        for (int turns = 0; turns < first; ++turns) before += tally.turns[turns];
+        for (int turns = last + 1; turns <= MaxTurns; ++turns) after += tally.turns[turns];
+        if (before > 0) {
+            printShare(("< " + std::to_string(first)).c_str(), before, tally.victories);
+        }
+        for (int turns = first; turns <= last; ++turns) {
+            std::string label = turns == MaxTurns ? std::to_string(turns) + "+" : std::to_string(turns);
+            printShare(label.c_str(), tally.turns[turns], tally.victories);
+        }
+        if (after > 0) {
+            printShare(("> " + std::to_string(last)).c_str(), after, tally.victories);
+        }
+
+        meanInterval(tally.hpSum, tally.hpSquares, tally.victories, mean, halfWidth);
+        std::printf("  HP left on a win  mean %.2f%% +/- %.2f%%\n", 100.0 * mean, 100.0 * halfWidth);
+        for (int bin = 0; bin < HpBins; ++bin) {
+            std::string label = std::to_string(bin * 100 / HpBins) + "-" + std::to_string((bin + 1) * 100 / HpBins) + "%";
+            printShare(label.c_str(), tally.hp[bin], tally.victories);
+        }
+    }
+
+    Tally simulate(JobSystem& jobs, bool serial, Encounter encounter, const Policy& policy,
+                   const std::vector<FastRNG>& streams, std::uint64_t battles) {
+        const CombatEngine::State start = CombatEngine::makeEncounterState(encounter);
+        const std::size_t chunks = streams.size();
+        std::vector<Tally> tallies(chunks);
+
+        auto body = [&](std::size_t begin, std::size_t end) {
+            CombatEngine engine;
+            for (std::size_t chunk = begin; chunk < end; ++chunk) {
+                FastRNG rng = streams[chunk];
+                std::uint64_t count = battles / chunks + (chunk < battles % chunks ? 1 : 0);
+                for (std::uint64_t i = 0; i < count; ++i) {
+                    runBattle(engine, start, policy, rng, tallies[chunk]);
+                }
+            }
+        };
+        if (serial) {
+            body(0, chunks);
+        } else {
+            jobs.parallelFor(chunks, 1, body);
+        }
+
+        Tally total;
+        for (const Tally& tally : tallies) total.merge(tally);
+        return total;
+    }
+
+    // The whole value as a decimal number; std::stoull would throw on "abc"
+    template <typename T>
+    bool parseNumber(const std::string& value, T& out) {
+        const char* end = value.data() + value.size();
+        auto [last, error] = std::from_chars(value.data(), end, out);
+        return error == std::errc() && last == end;
+    }
+
+    template <typename T>
+    bool parseChoice(const std::string& value, const std::vector<std::string>& names, T& out) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (value == names[i]) {
+                out = static_cast<T>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* usage = " [--battles N] [--enemy chalamander|bisasam|boss|all] [--coin head|tail|random]"
+                        " [--attack strike|thunderbolt|electroball|volttackle|random]"
+                        " [--defense quickguard|agility|charge|random] [--seed S] [--threads T] [--exact]";
+    const std::vector<std::string> encounterNames = {"chalamander", "bisasam", "boss"};
+
+    std::uint64_t battles = 10000000;
+    std::uint64_t seed = 42;
+    std::size_t threads = 0;
+    std::vector<Encounter> encounters = {Encounter::Chalamander, Encounter::Bisasam, Encounter::Boss};
+    Policy policy;
+    bool exact = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << usage << std::endl;
+            return 0;
+        }
+        else if (arg == "--exact") {
+            exact = true;
+        }
+        else if (arg == "--battles" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], battles);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], seed);
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            ok = parseNumber(argv[++i], threads);
+        }
+        else if (arg == "--enemy" && i + 1 < argc) {
+            std::string value = argv[++i];
+            Encounter encounter;
+            if (value == "all") {
+                encounters = {Encounter::Chalamander, Encounter::Bisasam, Encounter::Boss};
+            } else if ((ok = parseChoice(value, encounterNames, encounter))) {
+                encounters = {encounter};
+            }
+        }
+        else if (arg == "--coin" && i + 1 < argc) {
+            ok = parseChoice(argv[++i], {"head", "tail", "random"}, policy.coin);
+        }
+        else if (arg == "--attack" && i + 1 < argc) {
+            ok = parseChoice(argv[++i], {"strike", "thunderbolt", "electroball", "volttackle", "random"}, policy.attack);
+        }
+        else if (arg == "--defense" && i + 1 < argc) {
+            ok = parseChoice(argv[++i], {"quickguard", "agility", "charge", "random"}, policy.defense);
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok || battles == 0) {
+            std::cerr << "Bad argument: " << arg << std::endl;
+            std::cerr << "Usage: " << argv[0] << usage << std::endl;
+            return 1;
+        }
+    }
+
+    // The calling thread works too, so one worker fewer than requested;
+    // --threads 1 keeps everything on the calling thread
+    const bool serial = threads == 1;
+    JobSystem jobs(threads > 1 ? threads - 1 : (serial ? 1 : 0));
+    std::size_t workers = serial ? 1 : jobs.getWorkerCount() + 1;
+
+    // Stream k is the seed's generator jumped k times: 2^128 draws apart
+    std::vector<FastRNG> streams;
+    streams.reserve(ChunkCount);
+    FastRNG stream(seed);
+    for (std::size_t i = 0; i < std::min<std::uint64_t>(ChunkCount, battles); ++i) {
+        streams.push_back(stream);
+        stream.jump();
+    }
+
+    std::printf("Win-rate simulation: %llu battles per encounter, seed %llu, %zu threads\n",
+                static_cast<unsigned long long>(battles), static_cast<unsigned long long>(seed), workers);
+    if (std::find(encounters.begin(), encounters.end(), Encounter::Boss) != encounters.end()) {
+        std::printf("The boss only attacks here; in the game it also picks Power Strike and Guard by search\n");
+    }
+    for (Encounter encounter : encounters) {
+        auto start = Clock::now();
+        Tally tally = simulate(jobs, serial, encounter, policy, streams, battles);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report(encounterNames[static_cast<int>(encounter)].c_str(), tally, seconds);
+        if (exact) {
+            reportExact(encounter, policy, tally);
+        }
+    }
+    return 0;
+}